@@ -108,6 +108,7 @@
 #include "src/DataStructs/PortStatusStruct.h"
 #include "src/DataStructs/ProtocolStruct.h"
 #include "src/DataStructs/RTCStruct.h"
+#include "src/DataStructs/SyslogQueue.h"
 #include "src/DataStructs/SystemTimerStruct.h"
 #include "src/DataStructs/TimingStats.h"
 #include "src/DataStructs/tcp_cleanup.h"
@@ -131,6 +132,7 @@
 #include "src/Globals/EventQueue.h"
 #include "src/Globals/ExtraTaskSettings.h"
 #include "src/Globals/GlobalMapPortStatus.h"
+#include "src/Globals/Logging.h"
 #include "src/Globals/MQTT.h"
 #include "src/Globals/NetworkState.h"
 #include "src/Globals/Plugins.h"
@@ -701,6 +703,7 @@ void backgroundtasks()
     #endif
   }
   process_serialWriteBuffer();
+  syslogQueue.process();
   if(!UseRTOSMultitasking){
     serial();
     if (webserverRunning) {
@@ -40,6 +40,7 @@ bool CPlugin_002(CPlugin::Function function, struct EventStruct *event, String&
       Protocol[protocolCount].usesExtCreds = true;
       Protocol[protocolCount].defaultPort  = 1883;
       Protocol[protocolCount].usesID       = true;
+      Protocol[protocolCount].usesBatch    = true;
       break;
     }
 
@@ -109,6 +110,7 @@ bool CPlugin_002(CPlugin::Function function, struct EventStruct *event, String&
               String action;
               bool   mustSendEvent = false;
 
+              // N.B. Plugins handled here must also be listed in updateDomoticzIdxCache()
               switch (Settings.TaskDeviceNumber[x]) {
                 case 1: // temp solution, if input switch, update state
                 {
@@ -205,69 +207,22 @@ bool CPlugin_002(CPlugin::Function function, struct EventStruct *event, String&
     {
       if (event->idx != 0)
       {
+        // The constant parts of the JSON payload are rendered once per task.
         String json;
-        {
-          DynamicJsonDocument root(200);
-          root[F("idx")]  = event->idx;
-          root[F("RSSI")] = mapRSSItoDomoticz();
-            # if FEATURE_ADC_VCC
-          root[F("Battery")] = mapVccToDomoticz();
-            # endif // if FEATURE_ADC_VCC
-
-          const Sensor_VType sensorType = event->getSensorType();
-
-          switch (sensorType)
-          {
-            case Sensor_VType::SENSOR_TYPE_SWITCH:
-              root[F("command")] = String(F("switchlight"));
-
-              if (UserVar[event->BaseVarIndex] == 0) {
-                root[F("switchcmd")] = String(F("Off"));
-              }
-              else {
-                root[F("switchcmd")] = String(F("On"));
-              }
-              break;
-            case Sensor_VType::SENSOR_TYPE_DIMMER:
-              root[F("command")] = String(F("switchlight"));
-
-              if (UserVar[event->BaseVarIndex] == 0) {
-                root[F("switchcmd")] = String(F("Off"));
-              }
-              else {
-                root[F("Set%20Level")] = UserVar[event->BaseVarIndex];
-              }
-              break;
-
-            case Sensor_VType::SENSOR_TYPE_SINGLE:
-            case Sensor_VType::SENSOR_TYPE_LONG:
-            case Sensor_VType::SENSOR_TYPE_DUAL:
-            case Sensor_VType::SENSOR_TYPE_TRIPLE:
-            case Sensor_VType::SENSOR_TYPE_QUAD:
-            case Sensor_VType::SENSOR_TYPE_TEMP_HUM:
-            case Sensor_VType::SENSOR_TYPE_TEMP_BARO:
-            case Sensor_VType::SENSOR_TYPE_TEMP_EMPTY_BARO:
-            case Sensor_VType::SENSOR_TYPE_TEMP_HUM_BARO:
-            case Sensor_VType::SENSOR_TYPE_WIND:
-            case Sensor_VType::SENSOR_TYPE_STRING:
-            default:
-              root[F("nvalue")] = 0;
-              root[F("svalue")] = formatDomoticzSensorType(event);
-              break;
-          }
+        formatDomoticzMQTTpayload(event, json);
+# ifndef BUILD_NO_DEBUG
 
-          serializeJson(root, json);
+        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+          String log = F("MQTT : ");
+          log += json;
+          addLog(LOG_LEVEL_DEBUG, log);
         }
-# ifndef BUILD_NO_DEBUG
-        String log = F("MQTT : ");
-        log += json;
-        addLog(LOG_LEVEL_DEBUG, log);
 # endif // ifndef BUILD_NO_DEBUG
 
         String pubname = CPlugin_002_pubname;
         parseControllerVariables(pubname, event, false);
 
-        success = MQTTpublish(event->ControllerIndex, pubname.c_str(), json.c_str(), CPlugin_002_mqtt_retainFlag);
+        success = MQTTpublish(event->ControllerIndex, std::move(pubname), std::move(json), CPlugin_002_mqtt_retainFlag);
       } // if ixd !=0
       else
       {
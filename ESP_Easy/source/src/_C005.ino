@@ -36,6 +36,7 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
       Protocol[protocolCount].usesExtCreds = true;
       Protocol[protocolCount].defaultPort  = 1883;
       Protocol[protocolCount].usesID       = false;
+      Protocol[protocolCount].usesBatch    = true;
       break;
     }
 
@@ -82,7 +82,7 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
         // Element was added.
         // Now we try to append to the existing element
         // and thus preventing the need to create a long string only to copy it to a queue element.
-        C008_queue_element& element = C008_DelayHandler->sendQueue.back();
+        C008_queue_element& element = *C008_DelayHandler->getLast();
 
         // Collect the values at the same run, to make sure all are from the same sample
         LoadTaskSettings(event->TaskIndex);
@@ -47,6 +47,7 @@ bool CPlugin_011(CPlugin::Function function, struct EventStruct *event, String&
       Protocol[protocolCount].usesExtCreds = true;
       Protocol[protocolCount].defaultPort  = 80;
       Protocol[protocolCount].usesID       = false;
+      Protocol[protocolCount].usesBatch    = true;
       break;
     }
 
@@ -192,6 +193,34 @@ bool do_process_c011_delay_queue(int controller_number, const C011_queue_element
 
   int httpCode = -1;
 
+  // When batching is enabled, the body of the next queued requests to the same URI
+  // is appended (one line per request) to send them in a single request.
+  String postStr;
+  size_t batchCount = 1;
+
+  if (element.postStr.length() > 0) {
+    const size_t maxBatchCount = C011_DelayHandler->getBatchCount();
+
+    for (; batchCount < maxBatchCount; ++batchCount) {
+      const C011_queue_element *next = C011_DelayHandler->getElement(batchCount);
+
+      if ((next == nullptr) ||
+          (next->postStr.length() == 0) ||
+          !next->uri.equals(element.uri) ||
+          !next->HttpMethod.equals(element.HttpMethod) ||
+          !next->header.equals(element.header)) {
+        break;
+      }
+
+      if (batchCount == 1) {
+        postStr = element.postStr;
+      }
+      postStr += '\n';
+      postStr += next->postStr;
+    }
+  }
+  C011_DelayHandler->setBatchInProgress(batchCount);
+
   send_via_http(
     controller_number,
     ControllerSettings,
@@ -200,7 +229,7 @@ bool do_process_c011_delay_queue(int controller_number, const C011_queue_element
     element.uri,
     element.HttpMethod,
     element.header,
-    element.postStr,
+    (batchCount > 1) ? postStr : element.postStr,
     httpCode);
 
   // HTTP codes:
@@ -243,7 +272,7 @@ boolean Create_schedule_HTTP_C011(struct EventStruct *event)
     // Element was added.
     // Now we try to append to the existing element
     // and thus preventing the need to create a long string only to copy it to a queue element.
-    C011_queue_element& element = C011_DelayHandler->sendQueue.back();
+    C011_queue_element& element = *C011_DelayHandler->getLast();
 
     if (!load_C011_ConfigStruct(event->ControllerIndex, element.HttpMethod, element.uri, element.header, element.postStr))
     {
@@ -255,7 +284,7 @@ boolean Create_schedule_HTTP_C011(struct EventStruct *event)
         log += element.postStr;
         addLog(LOG_LEVEL_ERROR, log);
       }
-      C011_DelayHandler->sendQueue.pop_back();
+      C011_DelayHandler->removeLast();
       return false;
     }
 
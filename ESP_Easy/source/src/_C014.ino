@@ -148,6 +148,7 @@ bool CPlugin_014(CPlugin::Function function, struct EventStruct *event, String&
         Protocol[protocolCount].usesExtCreds = true;
         Protocol[protocolCount].defaultPort = 1883;
         Protocol[protocolCount].usesID = false;
+        Protocol[protocolCount].usesBatch = true;
         break;
       }
 
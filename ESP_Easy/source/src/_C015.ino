@@ -174,7 +174,7 @@ bool CPlugin_015(CPlugin::Function function, struct EventStruct *event, String&
         // Element was added.
         // Now we try to append to the existing element
         // and thus preventing the need to create a long string only to copy it to a queue element.
-        C015_queue_element& element = C015_DelayHandler->sendQueue.back();
+        C015_queue_element& element = *C015_DelayHandler->getLast();
         LoadTaskSettings(event->TaskIndex);
 
         for (byte x = 0; x < valueCount; x++)
@@ -787,6 +787,7 @@ bool C018_init(struct EventStruct *event) {
 
     LoadControllerSettings(event->ControllerIndex, ControllerSettings);
     C018_DelayHandler->configureControllerSettings(ControllerSettings);
+    C018_DelayHandler->applyQueueDepth();
     AppEUI             = getControllerUser(event->ControllerIndex, ControllerSettings);
     AppKey             = getControllerPass(event->ControllerIndex, ControllerSettings);
     SampleSetInitiator = ControllerSettings.SampleSetInitiator;
@@ -89,6 +89,7 @@ boolean Plugin_001(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].TenPerSecond       = true;
       break;
     }
 
@@ -713,6 +714,13 @@ boolean Plugin_001(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("inputswitchstate");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       String log;
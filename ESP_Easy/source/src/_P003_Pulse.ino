@@ -244,6 +244,13 @@ boolean Plugin_003(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("resetpulsecounter,setpulsecountertotal");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       String command            = parseString(string, 1);
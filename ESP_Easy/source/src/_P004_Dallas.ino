@@ -172,6 +172,8 @@ boolean Plugin_004(byte function, struct EventStruct *event, String& string)
               }
               Dallas_show_sensor_stats_webform_load(P004_data->get_sensor_data(i));
             }
+            addFormSeparator(2);
+            Dallas_show_bus_stats_webform_load(P004_data->get_gpio_rx());
           }
         }
       }
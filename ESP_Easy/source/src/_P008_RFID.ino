@@ -70,6 +70,7 @@ boolean Plugin_008(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].SendDataOption = true;
         Device[deviceCount].TimerOption = false;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].OncePerSecond    = true;
         break;
       }
 
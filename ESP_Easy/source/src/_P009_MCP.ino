@@ -73,6 +73,7 @@ boolean Plugin_009(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].TenPerSecond       = true;
       break;
     }
 
@@ -565,6 +566,13 @@ boolean Plugin_009(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = String(); // No commands handled
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       //String log;
@@ -75,6 +75,13 @@ boolean Plugin_011(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("extgpio,extpwm,extpulse,extlongpulse,status");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       String log;
@@ -49,6 +49,8 @@ boolean Plugin_012(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 0;
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
+      Device[deviceCount].TenPerSecond       = true;
+      Device[deviceCount].OncePerSecond      = true;
       break;
     }
 
@@ -218,6 +220,13 @@ boolean Plugin_012(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("lcd,lcdcmd");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       P012_data_struct *P012_data =
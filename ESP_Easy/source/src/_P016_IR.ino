@@ -130,6 +130,8 @@ boolean Plugin_016(byte function, struct EventStruct *event, String &string)
     Device[deviceCount].ValueCount = 1;
     Device[deviceCount].SendDataOption = true;
     Device[deviceCount].TimerOption = false;
+    Device[deviceCount].TenPerSecond = true;
+    Device[deviceCount].OncePerSecond = true;
     break;
   }
 
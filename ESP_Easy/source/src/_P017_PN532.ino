@@ -53,6 +53,7 @@ boolean Plugin_017(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].TenPerSecond       = true;
       break;
     }
 
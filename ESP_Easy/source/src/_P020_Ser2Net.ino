@@ -31,6 +31,7 @@ boolean Plugin_020(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].Type        = DEVICE_TYPE_SINGLE;
       Device[deviceCount].Custom      = true;
       Device[deviceCount].TimerOption = false;
+      Device[deviceCount].TenPerSecond = true;
       break;
     }
 
@@ -331,6 +332,13 @@ boolean Plugin_020(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("serialsend");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       String command = parseString(string, 1);
@@ -31,6 +31,7 @@ boolean Plugin_021(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].ValueCount = 1;
         Device[deviceCount].SendDataOption = true;
         Device[deviceCount].TimerOption = false;
+        Device[deviceCount].TenPerSecond = true;
         break;
       }
 
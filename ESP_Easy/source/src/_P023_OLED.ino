@@ -38,6 +38,8 @@ boolean Plugin_023(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 0;
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
+      Device[deviceCount].TenPerSecond       = true;
+      Device[deviceCount].OncePerSecond      = true;
       break;
     }
 
@@ -235,6 +237,13 @@ boolean Plugin_023(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("oled,oledcmd");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       P023_data_struct *P023_data =
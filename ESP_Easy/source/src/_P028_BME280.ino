@@ -36,6 +36,7 @@ boolean Plugin_028(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].OncePerSecond      = true;
       break;
     }
 
@@ -274,6 +274,7 @@ boolean Plugin_031(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].SendDataOption = true;
         Device[deviceCount].TimerOption = true;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].TenPerSecond     = true;
         break;
       }
 
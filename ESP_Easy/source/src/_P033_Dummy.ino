@@ -79,6 +79,13 @@ boolean Plugin_033(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("dummyvalueset");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       String command = parseString(string, 1);
@@ -133,6 +133,13 @@ boolean Plugin_035(byte function, struct EventStruct *event, String &command)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      command = F("irsend,irsendac");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         String cmdCode = parseString(command,1);
@@ -120,6 +120,9 @@ boolean Plugin_036(uint8_t function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 0;
       Device[deviceCount].SendDataOption     = false;
       Device[deviceCount].TimerOption        = true;
+      Device[deviceCount].FiftyPerSecond     = true;
+      Device[deviceCount].TenPerSecond       = true;
+      Device[deviceCount].OncePerSecond      = true;
       break;
     }
 
@@ -718,6 +721,13 @@ boolean Plugin_036(uint8_t function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("oledframedcmd");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       P036_data_struct *P036_data =
@@ -111,6 +111,13 @@ boolean Plugin_038(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("neopixel,neopixelhsv,neopixelall,neopixelallhsv,neopixelline,neopixellinehsv");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         if (Plugin_038_pixels)
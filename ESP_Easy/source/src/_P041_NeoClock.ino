@@ -36,6 +36,7 @@ boolean Plugin_041(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].FormulaOption = false;
         Device[deviceCount].ValueCount = 0;
         Device[deviceCount].SendDataOption = false;
+        Device[deviceCount].OncePerSecond  = true;
         break;
       }
 
@@ -110,6 +111,13 @@ boolean Plugin_041(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("neoclockcolor,neotestall,neotestloop");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         String cmd = parseString(string, 1);
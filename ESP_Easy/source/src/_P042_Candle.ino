@@ -118,6 +118,8 @@ boolean Plugin_042(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].SendDataOption = true;
         Device[deviceCount].TimerOption = true;
         Device[deviceCount].GlobalSyncOption = false;
+        Device[deviceCount].FiftyPerSecond   = true;
+        Device[deviceCount].OncePerSecond    = true;
         break;
       }
 
@@ -41,6 +41,8 @@ boolean Plugin_044(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].Type = DEVICE_TYPE_SINGLE;
         Device[deviceCount].Custom = true;
         Device[deviceCount].TimerOption = false;
+        Device[deviceCount].TenPerSecond = true;
+        Device[deviceCount].OncePerSecond = true;
         break;
       }
 
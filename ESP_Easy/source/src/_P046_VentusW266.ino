@@ -147,6 +147,7 @@ boolean Plugin_046(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].FormulaOption = true;
         Device[deviceCount].SendDataOption = true;
         Device[deviceCount].ValueCount = 3;
+        Device[deviceCount].TenPerSecond = true;
         break;
       }
 
@@ -107,6 +107,12 @@ boolean Plugin_048(byte function, struct EventStruct *event, String& string) {
       break;
     }
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = F("motorshieldcmd");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
       String cmd = parseString(string, 1);
 
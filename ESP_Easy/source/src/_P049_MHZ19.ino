@@ -488,6 +488,13 @@ boolean Plugin_049(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("mhzcalibratezero,mhzreset,mhzabcenable,mhzabcdisable,mhzmeasurementrange1000,mhzmeasurementrange2000,mhzmeasurementrange3000,mhzmeasurementrange5000");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       P049_data_struct *P049_data =
@@ -223,6 +223,12 @@ boolean Plugin_052(byte function, struct EventStruct *event, String& string) {
     }
 
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = F("senseair_setrelay,senseair_setabcperiod");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
       String cmd    = parseString(string, 1);
       String param1 = parseString(string, 2);
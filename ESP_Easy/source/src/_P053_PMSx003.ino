@@ -173,6 +173,7 @@ boolean Plugin_053(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].SendDataOption = true;
         Device[deviceCount].TimerOption = true;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].TenPerSecond     = true;
         success = true;
         break;
       }
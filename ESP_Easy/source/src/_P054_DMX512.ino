@@ -88,6 +88,7 @@ boolean Plugin_054(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = false;
         Device[deviceCount].TimerOptional = false;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].TenPerSecond     = true;
         break;
       }
 
@@ -133,6 +134,13 @@ boolean Plugin_054(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("dmx");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         String lowerString=string;
@@ -113,6 +113,7 @@ boolean Plugin_055(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = false;
         Device[deviceCount].TimerOptional = false;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].FiftyPerSecond   = true;
         break;
       }
 
@@ -208,6 +209,13 @@ boolean Plugin_055(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("chime,chimeplay,chimesave");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         if (!Plugin_055_Data)
@@ -92,6 +92,7 @@ boolean Plugin_057(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].TimerOptional      = false;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].TenPerSecond       = true;
       break;
     }
 
@@ -163,6 +164,13 @@ boolean Plugin_057(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("m,mx,mnum,mprint,mbr");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       P057_data_struct *P057_data =
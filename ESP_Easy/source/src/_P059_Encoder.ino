@@ -46,6 +46,7 @@ boolean Plugin_059(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = true;
         Device[deviceCount].TimerOptional = true;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].TenPerSecond     = true;
         break;
       }
 
@@ -174,6 +175,13 @@ boolean Plugin_059(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("encwrite");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         if (P_059_sensordefs.count(event->TaskIndex) != 0)
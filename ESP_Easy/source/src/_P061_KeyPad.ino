@@ -82,6 +82,7 @@ boolean Plugin_061(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].FiftyPerSecond     = true;
       break;
     }
 
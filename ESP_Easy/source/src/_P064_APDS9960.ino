@@ -74,6 +74,7 @@ boolean Plugin_064(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].TimerOptional      = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].FiftyPerSecond     = true;
       break;
     }
 
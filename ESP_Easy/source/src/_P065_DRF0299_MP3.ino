@@ -112,6 +112,13 @@ boolean Plugin_065(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("play,stop,vol,eq");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         if (!P065_easySerial)
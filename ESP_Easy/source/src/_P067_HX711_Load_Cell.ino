@@ -160,6 +160,7 @@ boolean Plugin_067(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOption = true;
         Device[deviceCount].TimerOptional = false;
         Device[deviceCount].GlobalSyncOption = true;
+        Device[deviceCount].FiftyPerSecond   = true;
         break;
       }
 
@@ -468,6 +469,13 @@ boolean Plugin_067(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("tarechana,tarechanb");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         String command = parseString(string, 1);
@@ -166,6 +166,7 @@ boolean Plugin_070(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].SendDataOption = false;
         Device[deviceCount].TimerOption = false;
         Device[deviceCount].GlobalSyncOption = false;
+        Device[deviceCount].OncePerSecond    = true;
         break;
       }
 
@@ -259,6 +260,13 @@ boolean Plugin_070(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("clock");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         String lowerString=string;
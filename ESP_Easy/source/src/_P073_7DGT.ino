@@ -641,6 +641,8 @@ boolean Plugin_073(byte function, struct EventStruct *event, String& string) {
       Device[deviceCount].TimerOption        = false;
       Device[deviceCount].TimerOptional      = false;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].TenPerSecond       = true;
+      Device[deviceCount].OncePerSecond      = true;
       break;
     }
 
@@ -850,6 +852,12 @@ boolean Plugin_073(byte function, struct EventStruct *event, String& string) {
       break;
     }
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = F("7dn,7dt,7ddt,7dst,7dsd,7dtext,7dfont,7dbin,7don,7doff,7db");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
       success = p073_plugin_write(event, string);
       break;
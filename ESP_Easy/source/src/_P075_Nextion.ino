@@ -121,6 +121,8 @@ boolean Plugin_075(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption = true;
       Device[deviceCount].TimerOptional = true;         // Allow user to disable interval function.
       Device[deviceCount].GlobalSyncOption = true;
+      Device[deviceCount].TenPerSecond     = true;
+      Device[deviceCount].OncePerSecond    = true;
       break;
     }
 
@@ -125,6 +125,7 @@ boolean Plugin_076(byte function, struct EventStruct *event, String &string) {
     Device[deviceCount].SendDataOption = true;
     Device[deviceCount].TimerOption = true;
     Device[deviceCount].GlobalSyncOption = false;
+    Device[deviceCount].TenPerSecond     = true;
     break;
   }
 
@@ -425,6 +426,13 @@ boolean Plugin_076(byte function, struct EventStruct *event, String &string) {
     break;
   }
 
+  case PLUGIN_GET_COMMANDS:
+  {
+    string  = F("hlwreset,hlwcalibrate");
+    success = true;
+    break;
+  }
+
   case PLUGIN_WRITE:
     if (Plugin_076_hlw) {
       String command = parseString(string, 1);
@@ -191,6 +191,7 @@ boolean Plugin_077(byte function, struct EventStruct *event, String &string) {
     Device[deviceCount].TimerOption = true;
     Device[deviceCount].TimerOptional = true;
     Device[deviceCount].GlobalSyncOption = true;
+    Device[deviceCount].TenPerSecond     = true;
     break;
   }
 
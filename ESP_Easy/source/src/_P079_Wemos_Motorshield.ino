@@ -217,6 +217,12 @@ boolean Plugin_079(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = F("wemosmotorshieldcmd,lolinmotorshieldcmd");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
 
       byte   parse_error = false;
@@ -179,6 +179,7 @@ boolean Plugin_081(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOptional    = false;
       Device[deviceCount].GlobalSyncOption = true;
       Device[deviceCount].DecimalsOnly     = true;
+      Device[deviceCount].OncePerSecond    = true;
       break;
     }
 
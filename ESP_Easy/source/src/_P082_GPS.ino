@@ -74,6 +74,7 @@ boolean Plugin_082(byte function, struct EventStruct *event, String& string) {
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].FiftyPerSecond     = true;
       break;
     }
 
@@ -150,6 +150,12 @@ boolean Plugin_085(byte function, struct EventStruct *event, String& string) {
       break;
     }
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = String(); // No commands handled
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
       break;
     }
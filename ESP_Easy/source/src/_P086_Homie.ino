@@ -169,6 +169,13 @@ boolean Plugin_086(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("homievalueset");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         String command = parseString(string, 1);
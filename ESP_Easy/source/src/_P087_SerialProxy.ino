@@ -65,6 +65,7 @@ boolean Plugin_087(byte function, struct EventStruct *event, String& string) {
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = false;
+      Device[deviceCount].FiftyPerSecond     = true;
       break;
     }
 
@@ -217,6 +218,12 @@ boolean Plugin_087(byte function, struct EventStruct *event, String& string) {
       break;
     }
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = F("serialproxy_write");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
       String cmd = parseString(string, 1);
 
@@ -70,6 +70,8 @@ boolean Plugin_088(byte function, struct EventStruct *event, String& string)
         Device[deviceCount].TimerOptional = false;
         Device[deviceCount].GlobalSyncOption = false;
         Device[deviceCount].DecimalsOnly = false;
+        Device[deviceCount].TenPerSecond = true;
+        Device[deviceCount].OncePerSecond = true;
 
         break;
       }
@@ -140,6 +142,13 @@ boolean Plugin_088(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("heatpumpir");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         String heatpumpModel;
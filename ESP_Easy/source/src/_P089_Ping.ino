@@ -204,6 +204,13 @@ boolean Plugin_089(byte function, struct EventStruct *event, String& string)
     break;
   }
 
+  case PLUGIN_GET_COMMANDS:
+  {
+    string  = F("pingset");
+    success = true;
+    break;
+  }
+
   case PLUGIN_WRITE:
   {
     String command = parseString(string, 1);
@@ -88,6 +88,7 @@ boolean Plugin_090(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].ValueCount         = 2;
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
+      Device[deviceCount].OncePerSecond      = true;
       break;
     }
 
@@ -573,6 +573,13 @@ boolean Plugin_091(byte function, struct EventStruct *event, String& string)
         break;
       }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      string  = F("relay,relaypulse,relaylongpulse,ydim");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
       {
         String log;
@@ -704,6 +704,7 @@ boolean Plugin_093(byte function, struct EventStruct *event, String& string) {
       Device[deviceCount].SendDataOption = true;
       Device[deviceCount].TimerOption = true;
       Device[deviceCount].TimerOptional = true;
+      Device[deviceCount].TenPerSecond  = true;
       break;
     }
 
@@ -753,6 +754,12 @@ boolean Plugin_093(byte function, struct EventStruct *event, String& string) {
       break;
     }
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = F("mitsubishihp");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
       if (parseString(string, 1).equalsIgnoreCase(F("MitsubishiHP"))) {
         P093_data_struct* heatPump = static_cast<P093_data_struct*>(getPluginTaskData(event->TaskIndex));
@@ -66,6 +66,7 @@ boolean Plugin_094(byte function, struct EventStruct *event, String& string) {
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = false;
+      Device[deviceCount].FiftyPerSecond     = true;
       break;
     }
 
@@ -225,6 +226,12 @@ boolean Plugin_094(byte function, struct EventStruct *event, String& string) {
       break;
     }
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = F("culreader_write");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
       String cmd = parseString(string, 1);
 
@@ -68,6 +68,15 @@ DF - Below doesn't look right; needs a RS485 to TTL(3.3v) level converter (see h
 
 #define P108_MEASUREMENT_INTERVAL 60000L
 
+// All used registers (0x00 ... 0x11) are read using 2 range requests.
+// The reserved registers 0x02 ... 0x07 are skipped, as the meter may reply with an exception.
+#define P108_FIRST_REGISTER 0x00
+#define P108_NR_REGISTERS   18
+#define P108_RANGE1_FIRST   0x00 // Total energy
+#define P108_RANGE1_COUNT   2
+#define P108_RANGE2_FIRST   0x08 // Export energy ... frequency
+#define P108_RANGE2_COUNT   10
+
 #include <ESPeasySerial.h>
 #include "src/Helpers/Modbus_RTU.h"
 
@@ -91,7 +100,56 @@ struct P108_data_struct : public PluginTaskData_base {
     return modbus.isInitialized();
   }
 
+  // Start reading all registers, without waiting for the reply.
+  bool startRead() {
+    if (!modbus.startReadHoldingRegisters(P108_RANGE1_FIRST, P108_RANGE1_COUNT)) {
+      return false;
+    }
+    measurementStart = millis();
+    readingRange2    = false;
+    readFinished     = false;
+    return true;
+  }
+
+  // Collect the reply, returns true when the read of both ranges has finished.
+  bool processRead() {
+    byte errorcode = 0;
+
+    if (!modbus.pollTransaction(errorcode)) {
+      return false;
+    }
+    const byte first = readingRange2 ? P108_RANGE2_FIRST : P108_RANGE1_FIRST;
+    const byte count = readingRange2 ? P108_RANGE2_COUNT : P108_RANGE1_COUNT;
+
+    valuesValid = (errorcode == 0) &&
+                  (modbus.getRegisters(&registers[first - P108_FIRST_REGISTER], count) == count);
+
+    if (valuesValid && !readingRange2) {
+      readingRange2 = modbus.startReadHoldingRegisters(P108_RANGE2_FIRST, P108_RANGE2_COUNT);
+
+      if (readingRange2) {
+        return false;
+      }
+      valuesValid = false;
+    }
+    readFinished = true;
+    return true;
+  }
+
+  uint16_t getRegister(byte address) const {
+    return registers[address - P108_FIRST_REGISTER];
+  }
+
+  uint32_t get_32b_Register(byte address) const {
+    return (static_cast<uint32_t>(getRegister(address)) << 16) | getRegister(address + 1);
+  }
+
   ModbusRTU_struct modbus;
+  uint16_t         registers[P108_NR_REGISTERS] = { 0 };
+  unsigned long    measurementStart             = 0;
+  bool             valuesValid                  = false;
+  bool             readingRange2                = false;
+  bool             readFinished                 = false; // Reply received, not yet processed by PLUGIN_READ
 };
 
 unsigned int _plugin_108_last_measurement = 0;
@@ -112,6 +170,7 @@ boolean Plugin_108(byte function, struct EventStruct *event, String& string) {
       Device[deviceCount].SendDataOption     = true;
       Device[deviceCount].TimerOption        = true;
       Device[deviceCount].GlobalSyncOption   = true;
+      Device[deviceCount].FiftyPerSecond     = true;
       break;
     }
 
@@ -162,6 +221,12 @@ boolean Plugin_108(byte function, struct EventStruct *event, String& string) {
       break;
     }
 
+    case PLUGIN_GET_COMMANDS: {
+      string  = String(); // No commands handled
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE: {
       break;
     }
@@ -308,11 +373,35 @@ boolean Plugin_108(byte function, struct EventStruct *event, String& string) {
         static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
 
       if ((nullptr != P108_data) && P108_data->isInitialized()) {
-        for (int i = 0; i < P108_NR_OUTPUT_VALUES; ++i) {
-          UserVar[event->BaseVarIndex + i] = p108_readValue(PCONFIG(i + P108_QUERY1_CONFIG_POS), event);
-          delay(1);
+        if (P108_data->readFinished) {
+          P108_data->readFinished = false;
+
+          // Try to get in sync with the existing interval again.
+          Scheduler.reschedule_task_device_timer(event->TaskIndex, P108_data->measurementStart);
+
+          if (P108_data->valuesValid) {
+            for (int i = 0; i < P108_NR_OUTPUT_VALUES; ++i) {
+              UserVar[event->BaseVarIndex + i] = p108_readValue(PCONFIG(i + P108_QUERY1_CONFIG_POS), event);
+            }
+            success = true;
+          }
+        } else if (!P108_data->modbus.isTransactionPending()) {
+          // The values will be sent when the reply has been received.
+          P108_data->startRead();
         }
+      }
+      break;
+    }
 
+    case PLUGIN_FIFTY_PER_SECOND: {
+      P108_data_struct *P108_data =
+        static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+      if ((nullptr != P108_data) && P108_data->modbus.isTransactionPending()) {
+        if (P108_data->processRead()) {
+          // Let PLUGIN_READ process the received values.
+          Scheduler.schedule_task_device_timer(event->TaskIndex, millis());
+        }
         success = true;
       }
       break;
@@ -350,44 +439,35 @@ int p108_storageValueToBaudrate(byte baudrate_setting) {
   return 9600;
 }
 
+// Compute the value from the last read registers.
 float p108_readValue(byte query, struct EventStruct *event) {
-  byte errorcode     = -1; // DF - not present in P085
-  float value = 0; // DF - not present in P085
   P108_data_struct *P108_data =
     static_cast<P108_data_struct *>(getPluginTaskData(event->TaskIndex));
 
-  if ((nullptr != P108_data) && P108_data->isInitialized()) {
-    switch (query) {
-      case P108_QUERY_V:
-        value = P108_data->modbus.readHoldingRegister(0x0C ,errorcode) / 10.0; // 0.1 V => V
-        break;
-      case P108_QUERY_A:
-        value = P108_data->modbus.readHoldingRegister(0x0D, errorcode) / 100.0; // 0.01 A => A
-        break;
-      case P108_QUERY_W:
-        value =  P108_data->modbus.readHoldingRegister(0x0E, errorcode) * 1.0 ;
-        break;
-      case P108_QUERY_VA:
-        value = P108_data->modbus.readHoldingRegister(0x0F, errorcode) * 1.0 ;
-        break;
-      case P108_QUERY_PF:
-        value = P108_data->modbus.readHoldingRegister(0x10, errorcode) / 1000.0; // 0.001 Pf => Pf
-        break;
-      case P108_QUERY_F:
-        value = P108_data->modbus.readHoldingRegister(0x11, errorcode) / 100.0 ; // 0.01 Hz => Hz
-        break;
-      case P108_QUERY_Wh_imp:
-        return P108_data->modbus.read_32b_HoldingRegister(0x0A) * 10.0;     // 0.01 kWh => Wh
-        break;
-      case P108_QUERY_Wh_exp:
-        return P108_data->modbus.read_32b_HoldingRegister(0x08) * 10.0;     // 0.01 kWh => Wh
-        break;
-      case P108_QUERY_Wh_tot:
-        return P108_data->modbus.read_32b_HoldingRegister(0x00) * 10.0;     // 0.01 kWh => Wh
-        break;
-    }
+  if ((nullptr == P108_data) || !P108_data->valuesValid) {
+    return 0.0f;
+  }
+
+  switch (query) {
+    case P108_QUERY_V:
+      return P108_data->getRegister(0x0C) / 10.0;      // 0.1 V => V
+    case P108_QUERY_A:
+      return P108_data->getRegister(0x0D) / 100.0;     // 0.01 A => A
+    case P108_QUERY_W:
+      return P108_data->getRegister(0x0E) * 1.0;
+    case P108_QUERY_VA:
+      return P108_data->getRegister(0x0F) * 1.0;
+    case P108_QUERY_PF:
+      return P108_data->getRegister(0x10) / 1000.0;    // 0.001 Pf => Pf
+    case P108_QUERY_F:
+      return P108_data->getRegister(0x11) / 100.0;     // 0.01 Hz => Hz
+    case P108_QUERY_Wh_imp:
+      return P108_data->get_32b_Register(0x0A) * 10.0; // 0.01 kWh => Wh
+    case P108_QUERY_Wh_exp:
+      return P108_data->get_32b_Register(0x08) * 10.0; // 0.01 kWh => Wh
+    case P108_QUERY_Wh_tot:
+      return P108_data->get_32b_Register(0x00) * 10.0; // 0.01 kWh => Wh
   }
-  if (errorcode == 0) return value; // DF - not present in P085
   return 0.0f;
 }
 
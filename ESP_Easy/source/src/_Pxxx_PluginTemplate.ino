@@ -114,6 +114,9 @@ boolean Plugin_xxx(byte function, struct EventStruct *event, String& string)
       Device[deviceCount].TimerOption        = false;                            // Allow to set the "Interval" timer for the plugin.
       Device[deviceCount].TimerOptional      = false;                            // When taskdevice timer is not set and not optional, use default "Interval" delay (Settings.Delay)
       Device[deviceCount].DecimalsOnly       = true;                             // Allow to set the number of decimals (otherwise treated a 0 decimals)
+      Device[deviceCount].FiftyPerSecond     = false;                            // Plugin handles PLUGIN_FIFTY_PER_SECOND
+      Device[deviceCount].TenPerSecond       = true;                             // Plugin handles PLUGIN_TEN_PER_SECOND
+      Device[deviceCount].OncePerSecond      = true;                             // Plugin handles PLUGIN_ONCE_A_SECOND
       break;
     }
 
@@ -260,6 +263,16 @@ boolean Plugin_xxx(byte function, struct EventStruct *event, String& string)
       break;
     }
 
+    case PLUGIN_GET_COMMANDS:
+    {
+      // Return the (lower case) commands handled in PLUGIN_WRITE, separated by a comma.
+      // Commands not in this list will not be offered to tasks of this plugin.
+      // When not handled, all commands are offered to the tasks of this plugin.
+      string  = F("dothis");
+      success = true;
+      break;
+    }
+
     case PLUGIN_WRITE:
     {
       // this case defines code to be executed when the plugin executes an action (command).
@@ -36,6 +36,8 @@
 #include "../Commands/wd.h"
 #include "../Commands/WiFi.h"
 
+#include "../DataStructs/TimingStats.h"
+
 #include "../ESPEasyCore/ESPEasy_Log.h"
 
 #include "../Helpers/Misc.h"
@@ -541,7 +543,9 @@ bool ExecuteCommand(taskIndex_t            taskIndex,
     // Use a tmp string to call PLUGIN_WRITE, since PluginCall may inadvertenly
     // alter the string.
     String tmpAction(action);
+    START_TIMER;
     bool   handled = PluginCall(PLUGIN_WRITE, &TempEvent, tmpAction);
+    STOP_TIMER(PLUGIN_CALL_WRITE);
     
     #ifndef BUILD_NO_DEBUG
     if (!tmpAction.equals(action)) {
@@ -15,13 +15,21 @@
 #include "../Helpers/StringConverter.h"
 
 #include <Arduino.h>
-#include <list>
 #include <memory> // For std::shared_ptr
 #include <new>    // std::nothrow
+#include <utility>
+#include <vector>
+
+#ifndef CONTROLLER_DELAY_QUEUE_HEAP_CHECK_INTERVAL
+# define CONTROLLER_DELAY_QUEUE_HEAP_CHECK_INTERVAL  100 // msec a successful free heap check is considered valid
+#endif // ifndef CONTROLLER_DELAY_QUEUE_HEAP_CHECK_INTERVAL
 
 
 /*********************************************************************************************\
 * ControllerDelayHandlerStruct
+* The queue is a ring buffer with a fixed number of slots, sized to the max. queue depth.
+* Elements are moved into a slot, so adding does not allocate memory for the queue itself.
+* The memory used by the queued elements is kept up to date in a running counter.
 \*********************************************************************************************/
 template<class T>
 struct ControllerDelayHandlerStruct {
@@ -32,7 +40,19 @@ struct ControllerDelayHandlerStruct {
     attempt(0),
     max_retries(CONTROLLER_DELAY_QUEUE_RETRY_DFLT),
     delete_oldest(false),
-    must_check_reply(false) {}
+    must_check_reply(false),
+    batch_size(1),
+    batch_flush_interval(0),
+    _head(0),
+    _count(0),
+    _queueMemorySize(0),
+    _lastHeapCheckOk(0),
+    _batchInProgress(1),
+    _lastSizeDirty(false),
+    _addedCount(0),
+    _addedMemorySize(0) {
+    resizeQueue(max_queue_depth);
+  }
 
   void configureControllerSettings(const ControllerSettingsStruct& settings) {
     minTimeBetweenMessages = settings.MinimalTimeBetweenMessages;
@@ -40,6 +60,8 @@ struct ControllerDelayHandlerStruct {
     max_retries            = settings.MaxRetry;
     delete_oldest          = settings.DeleteOldest;
     must_check_reply       = settings.MustCheckReply;
+    batch_size             = settings.BatchSize;
+    batch_flush_interval   = settings.BatchFlushInterval;
 
     // Set some sound limits when not configured
     if (max_queue_depth == 0) { max_queue_depth = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT; }
@@ -50,6 +72,16 @@ struct ControllerDelayHandlerStruct {
 
     // No less than 10 msec between messages.
     if (minTimeBetweenMessages < 10) { minTimeBetweenMessages = 10; }
+
+    if (batch_size == 0) { batch_size = 1; }
+
+    if (batch_size > max_queue_depth) { batch_size = max_queue_depth; }
+  }
+
+  // Resize the queue to the configured max. queue depth, without removing queued elements.
+  // Must not be called while an element returned by getNext() is in use, as it may be moved.
+  void applyQueueDepth() {
+    resizeQueue(max_queue_depth);
   }
 
   bool readyToProcess(const T& element) const {
@@ -64,13 +96,22 @@ struct ControllerDelayHandlerStruct {
   }
 
   bool queueFull(const T& element) const {
-    if (sendQueue.size() >= max_queue_depth) { return true; }
+    if ((_count >= _queue.size()) || (_count >= max_queue_depth)) { return true; }
 
-    // Number of elements is not exceeding the limit, check memory
+    // Number of elements is not exceeding the limit, check memory.
+    // Only a successful check is remembered for a short while,
+    // so a low memory situation is always checked again.
+    if ((_lastHeapCheckOk != 0) && (timePassedSince(_lastHeapCheckOk) < CONTROLLER_DELAY_QUEUE_HEAP_CHECK_INTERVAL)) {
+      return false;
+    }
     int freeHeap = ESP.getFreeHeap();
 
-    if (freeHeap > 5000) { return false; // Memory is not an issue.
+    if (freeHeap > 5000) {
+      _lastHeapCheckOk = millis();
+      if (_lastHeapCheckOk == 0) { _lastHeapCheckOk = 1; }
+      return false; // Memory is not an issue.
     }
+    _lastHeapCheckOk = 0;
 #ifndef BUILD_NO_DEBUG
 
     if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
@@ -79,7 +120,7 @@ struct ControllerDelayHandlerStruct {
       log += " : Memory used: ";
       log += getQueueMemorySize();
       log += " bytes ";
-      log += sendQueue.size();
+      log += _count;
       log += " items ";
       log += freeHeap;
       log += " free";
@@ -92,18 +133,20 @@ struct ControllerDelayHandlerStruct {
   // Try to add to the queue, if permitted by "delete_oldest"
   // Return false when no item was added.
   bool addToQueue(T&& element) {
+    updateLastSize();
+
     if (delete_oldest) {
       // Force add to the queue.
       // If max buffer is reached, the oldest in the queue (first to be served) will be removed.
-      while (queueFull(element)) {
-        sendQueue.pop_front();
+      while (_count > 0 && queueFull(element)) {
+        removeFirst();
       }
-      sendQueue.emplace_back(element);
-      return true;
-    }
-
-    if (!queueFull(element)) {
-      sendQueue.emplace_back(element);
+      if (_count < _queue.size()) {
+        pushBack(std::move(element));
+        return true;
+      }
+    } else if (!queueFull(element)) {
+      pushBack(std::move(element));
       return true;
     }
 #ifndef BUILD_NO_DEBUG
@@ -118,29 +161,69 @@ struct ControllerDelayHandlerStruct {
     return false;
   }
 
+  // Get the last added element, to complete it after adding it to the queue.
+  // Return nullptr when the queue is empty.
+  T* getLast() {
+    if (_count == 0) { return nullptr; }
+
+    // Element may be changed, so its size must be computed again.
+    _lastSizeDirty = true;
+    return &_queue[getSlot(_count - 1)];
+  }
+
+  // Remove the last added element.
+  void removeLast() {
+    if (_count == 0) { return; }
+    updateLastSize();
+    const size_t slot = getSlot(_count - 1);
+    _queueMemorySize -= _sizes[slot];
+    clearSlot(slot);
+    --_count;
+  }
+
   // Get the next element.
-  // Remove front element when max_retries is reached.
+  // Remove front element (or the last tried batch) when max_retries is reached.
   T* getNext() {
-    if (sendQueue.empty()) { return NULL; }
+    if (_count == 0) { return NULL; }
 
     if (attempt > max_retries) {
-      sendQueue.pop_front();
-      attempt = 0;
+      removeFirst(_batchInProgress);
+      _batchInProgress = 1;
+      attempt          = 0;
 
-      if (sendQueue.empty()) { return NULL; }
+      if (_count == 0) { return NULL; }
     }
-    return &sendQueue.front();
+    return &_queue[_head];
+  }
+
+  // Number of elements a controller supporting batches may process at once.
+  // Returns 0 when the queue is empty.
+  size_t getBatchCount() const {
+    return (_count < batch_size) ? _count : batch_size;
+  }
+
+  // Get the element at the given position in the queue, 0 = first to be processed.
+  T* getElement(size_t index) {
+    if (index >= _count) { return nullptr; }
+    return &_queue[getSlot(index)];
+  }
+
+  // Set the number of elements (starting at the first) handled by the next call to markProcessed().
+  // A batch is retried and removed as a whole.
+  void setBatchInProgress(size_t count) {
+    _batchInProgress = (count == 0) ? 1 : count;
   }
 
   // Mark as processed and return time to schedule for next process.
   // Return 0 when nothing to process.
   // @param remove_from_queue indicates whether the elements should be removed from the queue.
   unsigned long markProcessed(bool remove_from_queue) {
-    if (sendQueue.empty()) { return 0; }
+    if (_count == 0) { return 0; }
 
     if (remove_from_queue) {
-      sendQueue.pop_front();
-      attempt = 0;
+      removeFirst(_batchInProgress);
+      _batchInProgress = 1;
+      attempt  = 0;
       lastSend = millis();
     } else {
       ++attempt;
@@ -149,9 +232,18 @@ struct ControllerDelayHandlerStruct {
   }
 
   unsigned long getNextScheduleTime() const {
-    if (sendQueue.empty()) { return 0; }
+    if (_count == 0) { return 0; }
     unsigned long nextTime = lastSend + minTimeBetweenMessages;
 
+    if ((batch_size > 1) && (_count < batch_size) && (batch_flush_interval > 0)) {
+      // Wait for the batch to fill up, but not longer than the flush interval after the oldest was added.
+      const unsigned long flushTime = _addedTime[_head] + batch_flush_interval;
+
+      if (timeDiff(nextTime, flushTime) > 0) {
+        nextTime = flushTime;
+      }
+    }
+
     if (timePassedSince(nextTime) > 0) {
       nextTime = millis();
     }
@@ -169,15 +261,24 @@ struct ControllerDelayHandlerStruct {
   }
 
   size_t getQueueMemorySize() const {
-    size_t totalSize = 0;
+    updateLastSize();
+    return _queueMemorySize;
+  }
 
-    for (auto it = sendQueue.begin(); it != sendQueue.end(); ++it) {
-      totalSize += it->getSize();
-    }
-    return totalSize;
+  // Average memory allocated per element added to the queue, e.g. bytes per publish.
+  size_t getAverageElementSize() const {
+    if (_addedCount == 0) { return 0; }
+    return _addedMemorySize / _addedCount;
+  }
+
+  size_t size() const {
+    return _count;
+  }
+
+  bool empty() const {
+    return _count == 0;
   }
 
-  std::list<T>  sendQueue;
   unsigned long lastSend;
   unsigned int  minTimeBetweenMessages;
   byte          max_queue_depth;
@@ -185,6 +286,90 @@ struct ControllerDelayHandlerStruct {
   byte          max_retries;
   bool          delete_oldest;
   bool          must_check_reply;
+  byte          batch_size;
+  unsigned int  batch_flush_interval;
+
+private:
+
+  size_t getSlot(size_t index) const {
+    return (_head + index) % _queue.size();
+  }
+
+  void pushBack(T&& element) {
+    const size_t slot = getSlot(_count);
+
+    _queue[slot]      = std::move(element);
+    _sizes[slot]      = _queue[slot].getSize();
+    _addedTime[slot]  = millis();
+    _queueMemorySize += _sizes[slot];
+    ++_count;
+
+    ++_addedCount;
+    _addedMemorySize += _sizes[slot];
+  }
+
+  void removeFirst(size_t nrElements = 1) {
+    updateLastSize();
+
+    for (; nrElements > 0 && _count > 0; --nrElements) {
+      _queueMemorySize -= _sizes[_head];
+      clearSlot(_head);
+      _head = getSlot(1);
+      --_count;
+    }
+  }
+
+  // Release the memory held by the element in the slot.
+  void clearSlot(size_t slot) {
+    _queue[slot] = T();
+    _sizes[slot] = 0;
+  }
+
+  void updateLastSize() const {
+    if (!_lastSizeDirty) { return; }
+    _lastSizeDirty = false;
+
+    if (_count == 0) { return; }
+    const size_t slot = getSlot(_count - 1);
+    _queueMemorySize -= _sizes[slot];
+    _sizes[slot]      = _queue[slot].getSize();
+    _queueMemorySize += _sizes[slot];
+  }
+
+  // Change the number of slots.
+  // Queued elements are kept, so the queue does not shrink below the number of queued elements.
+  void resizeQueue(size_t newSize) {
+    if (newSize < _count) { newSize = _count; }
+
+    if (newSize == _queue.size()) { return; }
+    updateLastSize();
+    std::vector<T>             queue(newSize);
+    std::vector<size_t>        sizes(newSize, 0);
+    std::vector<unsigned long> addedTime(newSize, 0);
+
+    for (size_t i = 0; i < _count; ++i) {
+      const size_t slot = getSlot(i);
+      queue[i]     = std::move(_queue[slot]);
+      sizes[i]     = _sizes[slot];
+      addedTime[i] = _addedTime[slot];
+    }
+    _queue.swap(queue);
+    _sizes.swap(sizes);
+    _addedTime.swap(addedTime);
+    _head = 0;
+  }
+
+  std::vector<T>              _queue;
+  mutable std::vector<size_t> _sizes;     // Memory size of the element in the slot
+  std::vector<unsigned long>  _addedTime; // Time the element in the slot was added
+  size_t                      _head;  // Slot of the first element to process
+  size_t                      _count; // Number of queued elements
+  mutable size_t              _queueMemorySize;
+  mutable unsigned long       _lastHeapCheckOk;
+  size_t                      _batchInProgress; // Number of elements handled by the controller in the current attempt
+  mutable bool                _lastSizeDirty;
+  uint64_t                    _addedCount;      // Number of elements added, for statistics
+  uint64_t                    _addedMemorySize; // Total memory of the added elements, for statistics
 };
 
 
@@ -254,6 +439,7 @@ struct ControllerDelayHandlerStruct {
     }                                                                                                                  \
     LoadControllerSettings(ControllerIndex, ControllerSettings);                                                       \
     C##NNN####M##_DelayHandler->configureControllerSettings(ControllerSettings);                                       \
+    C##NNN####M##_DelayHandler->applyQueueDepth();                                                                     \
     return true;                                                                                                       \
   }                                                                                                                    \
   void exit_c##NNN####M##_delay_queue() {                                                                              \
@@ -20,6 +20,7 @@ bool init_mqtt_delay_queue(controllerIndex_t ControllerIndex, String& pubname, b
     return false;
   }
   MQTTDelayHandler->configureControllerSettings(ControllerSettings);
+  MQTTDelayHandler->applyQueueDepth();
   pubname = ControllerSettings.Publish;
   retainFlag = ControllerSettings.mqtt_retainFlag();
   return true;
@@ -1,5 +1,7 @@
 #include "../ControllerQueue/MQTT_queue_element.h"
 
+#include <utility> // std::move
+
 
 MQTT_queue_element::MQTT_queue_element() {}
 
@@ -7,6 +9,21 @@ MQTT_queue_element::MQTT_queue_element(int ctrl_idx,
                                        const String& topic, const String& payload, bool retained) :
   _topic(topic), _payload(payload), controller_idx(ctrl_idx), _retained(retained)
 {
+  removeEmptyTopicSlots();
+}
+
+MQTT_queue_element::MQTT_queue_element(int ctrl_idx,
+                                       String&& topic, String&& payload, bool retained) :
+  _topic(std::move(topic)), _payload(std::move(payload)), controller_idx(ctrl_idx), _retained(retained)
+{
+  removeEmptyTopicSlots();
+}
+
+size_t MQTT_queue_element::getSize() const {
+  return sizeof(*this) + _topic.length() + _payload.length();
+}
+
+void MQTT_queue_element::removeEmptyTopicSlots() {
   // some parts of the topic may have been replaced by empty strings,
   // or "/status" may have been appended to a topic ending with a "/"
   // Get rid of "//"
@@ -14,7 +31,3 @@ MQTT_queue_element::MQTT_queue_element(int ctrl_idx,
     _topic.replace(F("//"), F("/"));
   }
 }
-
-size_t MQTT_queue_element::getSize() const {
-  return sizeof(*this) + _topic.length() + _payload.length();
-}
@@ -18,12 +18,22 @@ public:
                               const String& payload,
                               bool          retained);
 
+  // Take ownership of topic and payload, without copying.
+  explicit MQTT_queue_element(int      ctrl_idx,
+                              String&& topic,
+                              String&& payload,
+                              bool     retained);
+
   size_t getSize() const;
 
   String _topic;
   String _payload;
   controllerIndex_t controller_idx = INVALID_CONTROLLER_INDEX;
   bool _retained                   = false;
+
+private:
+
+  void removeEmptyTopicSlots();
 };
 
 
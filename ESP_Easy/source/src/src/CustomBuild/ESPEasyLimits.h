@@ -120,6 +120,40 @@
 #ifndef RULES_IF_MAX_NESTING_LEVEL
   #define RULES_IF_MAX_NESTING_LEVEL          4
 #endif
+#ifndef RULES_CACHE_MIN_FREE_MEM
+  #define RULES_CACHE_MIN_FREE_MEM        10240 // Min. free memory left after keeping a rules set in RAM
+#endif
+#ifndef EXTRA_TASK_SETTINGS_CACHE_MIN_FREE_MEM
+  #define EXTRA_TASK_SETTINGS_CACHE_MIN_FREE_MEM 10240 // Min. free memory left after caching task settings in RAM
+#endif
+#ifndef JSON_TASK_VALUES_CACHE_MIN_FREE_MEM
+  #define JSON_TASK_VALUES_CACHE_MIN_FREE_MEM 10240 // Min. free memory left after caching formatted task values for /json
+#endif
+#ifndef WEBSERVER_EVENTS_MAX_CLIENTS
+  #define WEBSERVER_EVENTS_MAX_CLIENTS        2 // Max. number of clients connected to /events
+#endif
+#ifndef PARSED_TEMPLATE_CACHE_MAX_ENTRIES
+  #define PARSED_TEMPLATE_CACHE_MAX_ENTRIES  32 // Max. number of templates kept pre-parsed for parseTemplate()
+#endif
+#ifndef PARSED_TEMPLATE_CACHE_MIN_FREE_MEM
+  #define PARSED_TEMPLATE_CACHE_MIN_FREE_MEM 10240 // Min. free memory left after caching a parsed template
+#endif
+#ifndef PARSED_TEMPLATE_CACHE_MAX_CANDIDATES
+  #define PARSED_TEMPLATE_CACHE_MAX_CANDIDATES 16 // Max. number of templates seen once, which will be cached when seen again
+#endif
+#ifndef PLUGIN_COMMAND_CACHE_MAX_ENTRIES
+  #define PLUGIN_COMMAND_CACHE_MAX_ENTRIES   16 // Max. number of plugin commands with their list of handling tasks kept in RAM
+#endif
+#ifndef EVENT_QUEUE_MAX
+  # ifdef ESP32
+    #  define EVENT_QUEUE_MAX                  64
+  # else // ifdef ESP32
+    #  define EVENT_QUEUE_MAX                  32
+  # endif // ifdef ESP32
+#endif
+#ifndef EVENT_QUEUE_DROP_LOG_INTERVAL
+  #define EVENT_QUEUE_DROP_LOG_INTERVAL   10000 // Min. time in msec between error logs about dropped rules events
+#endif
 
 
 // ***********************************************************************
@@ -142,6 +176,27 @@
 #ifndef UDP_PACKETSIZE_MAX
   #define UDP_PACKETSIZE_MAX               256 // Currently only needed for C013_Receive
 #endif
+#ifndef SYSLOG_QUEUE_MAX_SIZE
+  # ifdef ESP32
+    #  define SYSLOG_QUEUE_MAX_SIZE           4096 // Max. nr of bytes of log lines buffered to be sent to syslog
+  # else // ifdef ESP32
+    #  define SYSLOG_QUEUE_MAX_SIZE           1024 // Max. nr of bytes of log lines buffered to be sent to syslog
+  # endif // ifdef ESP32
+#endif
+#ifndef SYSLOG_QUEUE_MIN_FREE_MEM
+  #define SYSLOG_QUEUE_MIN_FREE_MEM        6000 // Drop syslog lines when free memory is below this value
+#endif
+#ifndef SYSLOG_MAX_PACKET_SIZE
+  #define SYSLOG_MAX_PACKET_SIZE           1024 // Max. size of a syslog UDP packet containing multiple lines
+#endif
+#ifndef SYSLOG_MAX_LINES_PER_PACKET
+  // Standard syslog servers (RFC 5426) handle each UDP packet as a single message.
+  // Only set to > 1 when the syslog server splits packets on '\n'.
+  #define SYSLOG_MAX_LINES_PER_PACKET         1 // Max. nr of lines sent in a single syslog UDP packet
+#endif
+#ifndef SYSLOG_SEND_INTERVAL
+  #define SYSLOG_SEND_INTERVAL               20 // Min. time in msec between syslog packets
+#endif
 #ifndef TIMER_GRATUITOUS_ARP_MAX
   #define TIMER_GRATUITOUS_ARP_MAX           5000
 #endif
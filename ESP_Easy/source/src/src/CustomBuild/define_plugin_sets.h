@@ -114,6 +114,9 @@ To create/register a plugin, you have to :
     #ifndef WEBSERVER_NEW_RULES
         #define WEBSERVER_NEW_RULES
     #endif
+    #ifndef WEBSERVER_EVENTS
+        #define WEBSERVER_EVENTS
+    #endif
 #endif
 
 #ifndef USE_CUSTOM_H
@@ -364,6 +367,9 @@ To create/register a plugin, you have to :
         #ifdef WEBSERVER_NEW_RULES
             #undef WEBSERVER_NEW_RULES
         #endif
+        #ifdef WEBSERVER_EVENTS
+            #undef WEBSERVER_EVENTS
+        #endif
 
 
     #endif // WEBSERVER_CUSTOM_BUILD_DEFINED
@@ -1,8 +1,12 @@
 #include "../DataStructs/Caches.h"
 
+#include "../DataTypes/ESPEasy_plugin_functions.h"
+#include "../DataStructs/SyslogQueue.h"
 #include "../Globals/Device.h"
+#include "../Globals/Logging.h"
 #include "../Globals/Settings.h"
 #include "../Globals/WiFi_AP_Candidates.h"
+#include "../Helpers/Memory.h"
 
 #include <ESPeasySerial.h>
 
@@ -12,11 +16,22 @@ void Caches::clearAllCaches()
   fileExistsMap.clear();
   updateTaskCaches();
   WiFi_AP_Candidates.clearCache();
+  syslogQueue.clearHeaderCache();
 }
 
 void Caches::updateTaskCaches() {
   taskIndexName.clear();
   taskIndexValueName.clear();
+  taskFormula.clear();
+  domoticzIdx.clear();
+  domoticzIdxValid = false;
+  domoticzPayloadTemplate.clear();
+  extraTaskSettings.clear();
+  parsedTemplates.clear();
+  jsonTaskValues.clear();
+  ++jsonTaskValuesGeneration;
+  periodicCallTasksValid = false;
+  pluginCommandTasks.clear();
   updateActiveTaskUseSerial0();
 }
 
@@ -47,3 +62,126 @@ void Caches::updateActiveTaskUseSerial0() {
     }
   }
 }
+
+bool Caches::getCachedExtraTaskSettings(taskIndex_t TaskIndex, ExtraTaskSettingsStruct& settings)
+{
+  auto it = extraTaskSettings.find(TaskIndex);
+
+  if (it == extraTaskSettings.end()) {
+    return false;
+  }
+  it->second.lastUsed = ++extraTaskSettingsUseCounter;
+  settings            = it->second.settings;
+  return true;
+}
+
+void Caches::cacheExtraTaskSettings(const ExtraTaskSettingsStruct& settings)
+{
+  if (!validTaskIndex(settings.TaskIndex)) {
+    return;
+  }
+
+  // Make room by removing the least recently used tasks.
+  while (!extraTaskSettings.empty() &&
+         (FreeMem() < (sizeof(ExtraTaskSettingsCacheEntry) + EXTRA_TASK_SETTINGS_CACHE_MIN_FREE_MEM))) {
+    auto lru = extraTaskSettings.begin();
+
+    for (auto it = extraTaskSettings.begin(); it != extraTaskSettings.end(); ++it) {
+      if (it->second.lastUsed < lru->second.lastUsed) {
+        lru = it;
+      }
+    }
+    extraTaskSettings.erase(lru);
+  }
+
+  if (FreeMem() < (sizeof(ExtraTaskSettingsCacheEntry) + EXTRA_TASK_SETTINGS_CACHE_MIN_FREE_MEM)) {
+    return;
+  }
+  ExtraTaskSettingsCacheEntry& entry = extraTaskSettings[settings.TaskIndex];
+
+  entry.settings = settings;
+  entry.lastUsed = ++extraTaskSettingsUseCounter;
+}
+
+void Caches::clearCachedExtraTaskSettings(taskIndex_t TaskIndex)
+{
+  extraTaskSettings.erase(TaskIndex);
+}
+
+void Caches::markJsonTaskValuesChanged(taskIndex_t TaskIndex)
+{
+  ++jsonTaskValuesGeneration;
+  auto it = jsonTaskValues.find(TaskIndex);
+
+  if (it != jsonTaskValues.end()) {
+    it->second.json       = String();
+    it->second.generation = jsonTaskValuesGeneration;
+  }
+}
+
+const std::vector<taskIndex_t>& Caches::getPeriodicCallTasks(byte Function)
+{
+  if (!periodicCallTasksValid) {
+    updatePeriodicCallTasks();
+  }
+
+  switch (Function) {
+    case PLUGIN_FIFTY_PER_SECOND: return fiftyPerSecondTasks;
+    case PLUGIN_TEN_PER_SECOND:   return tenPerSecondTasks;
+    default:
+      break;
+  }
+  return oncePerSecondTasks;
+}
+
+void Caches::updatePeriodicCallTasks()
+{
+  fiftyPerSecondTasks.clear();
+  tenPerSecondTasks.clear();
+  oncePerSecondTasks.clear();
+
+  for (taskIndex_t task = 0; validTaskIndex(task); ++task)
+  {
+    const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(task);
+
+    if (Settings.TaskDeviceEnabled[task] && validDeviceIndex(DeviceIndex)) {
+      if (Device[DeviceIndex].FiftyPerSecond) { fiftyPerSecondTasks.push_back(task); }
+
+      if (Device[DeviceIndex].TenPerSecond) { tenPerSecondTasks.push_back(task); }
+
+      if (Device[DeviceIndex].OncePerSecond) { oncePerSecondTasks.push_back(task); }
+    }
+  }
+  periodicCallTasksValid = true;
+}
+
+bool Caches::getCachedPluginCommandTasks(const String& command, std::vector<taskIndex_t>& tasks)
+{
+  auto it = pluginCommandTasks.find(command);
+
+  if (it == pluginCommandTasks.end()) {
+    return false;
+  }
+  it->second.lastUsed = ++pluginCommandTasksUseCounter;
+  tasks               = it->second.tasks;
+  return true;
+}
+
+void Caches::cachePluginCommandTasks(const String& command, const std::vector<taskIndex_t>& tasks)
+{
+  // Make room by removing the least recently used command.
+  while (pluginCommandTasks.size() >= PLUGIN_COMMAND_CACHE_MAX_ENTRIES) {
+    auto lru = pluginCommandTasks.begin();
+
+    for (auto it = pluginCommandTasks.begin(); it != pluginCommandTasks.end(); ++it) {
+      if (it->second.lastUsed < lru->second.lastUsed) {
+        lru = it;
+      }
+    }
+    pluginCommandTasks.erase(lru);
+  }
+  PluginCommandTasks& entry = pluginCommandTasks[command];
+
+  entry.tasks    = tasks;
+  entry.lastUsed = ++pluginCommandTasksUseCounter;
+}
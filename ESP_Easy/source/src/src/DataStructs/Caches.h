@@ -2,12 +2,58 @@
 #define DATASTRUCTS_CACHES_H
 
 #include <map>
+#include <vector>
 #include "../../ESPEasy_common.h"
+#include "../DataStructs/DeviceStruct.h"
+#include "../DataStructs/ExtraTaskSettingsStruct.h"
+#include "../DataStructs/ParsedTemplateCache.h"
+#include "../DataTypes/ControllerIndex.h"
 #include "../Globals/Plugins.h"
+#include "../Helpers/Rules_calculate.h"
+
+// Compiled task value formulas of a single task.
+struct CompiledTaskFormulas {
+  CalculateProgram    program[VARS_PER_TASK];
+  CalculateReturnCode compileResult[VARS_PER_TASK];
+};
+
+// Constant parts of the JSON payload sent by Domoticz MQTT for a task.
+// Rendered once, only the values are formatted for each message.
+struct DomoticzPayloadTemplate {
+  String       prefix;      // e.g. {"idx":123,"RSSI":
+  String       valuePrefix; // e.g. ,"nvalue":0,"svalue":"
+  unsigned int idx        = 0;
+  Sensor_VType sensorType = Sensor_VType::SENSOR_TYPE_NONE;
+};
+
+// Copy of the ExtraTaskSettings of a task, as loaded from flash.
+struct ExtraTaskSettingsCacheEntry {
+  ExtraTaskSettingsStruct settings;
+  uint32_t                lastUsed = 0;
+};
+
+// Formatted "TaskValues" part of the /json output of a task.
+// Only valid as long as the raw task values are the same.
+struct JsonTaskValuesSnapshot {
+  uint32_t rawValues[VARS_PER_TASK] = { 0 };
+  uint32_t generation               = 0; // Value of Caches::jsonTaskValuesGeneration when the values last changed
+  String   json;                         // Empty when the values must be formatted again
+};
+
+// Tasks which may handle a command sent to the plugins, in order of task index.
+struct PluginCommandTasks {
+  std::vector<taskIndex_t> tasks;
+  uint32_t                 lastUsed = 0;
+};
 
 typedef std::map<String, taskIndex_t>TaskIndexNameMap;
 typedef std::map<String, byte>       TaskIndexValueNameMap;
 typedef std::map<String, bool>       FilePresenceMap;
+typedef std::map<taskIndex_t, CompiledTaskFormulas> TaskFormulaMap;
+typedef std::map<taskIndex_t, DomoticzPayloadTemplate> DomoticzPayloadTemplateMap;
+typedef std::map<taskIndex_t, ExtraTaskSettingsCacheEntry> ExtraTaskSettingsMap;
+typedef std::map<taskIndex_t, JsonTaskValuesSnapshot> JsonTaskValuesMap;
+typedef std::map<String, PluginCommandTasks> PluginCommandTasksMap;
 
 struct Caches {
   void clearAllCaches();
@@ -16,10 +62,71 @@ struct Caches {
 
   void updateActiveTaskUseSerial0();
 
+  // Copy the cached ExtraTaskSettings of the task into settings.
+  // Return false when the task is not (yet) cached.
+  bool getCachedExtraTaskSettings(taskIndex_t              TaskIndex,
+                                  ExtraTaskSettingsStruct& settings);
+
+  // Keep a copy of the loaded ExtraTaskSettings.
+  // The least recently used task is removed when free memory is low.
+  void cacheExtraTaskSettings(const ExtraTaskSettingsStruct& settings);
+
+  void clearCachedExtraTaskSettings(taskIndex_t TaskIndex);
+
+  // Task has sent new values, format again when served via /json
+  void markJsonTaskValuesChanged(taskIndex_t TaskIndex);
+
+  // Copy the cached list of tasks which may handle the (lower case) command.
+  // Return false when the command is not (yet) cached.
+  bool getCachedPluginCommandTasks(const String             & command,
+                                   std::vector<taskIndex_t>& tasks);
+
+  // The least recently used command is removed when the cache is full.
+  void cachePluginCommandTasks(const String                  & command,
+                               const std::vector<taskIndex_t>& tasks);
+
+  // Enabled tasks of plugins handling the periodic call (PLUGIN_FIFTY_PER_SECOND,
+  // PLUGIN_TEN_PER_SECOND or PLUGIN_ONCE_A_SECOND), in order of task index.
+  const std::vector<taskIndex_t>& getPeriodicCallTasks(byte Function);
+
   TaskIndexNameMap      taskIndexName;
   TaskIndexValueNameMap taskIndexValueName;
   FilePresenceMap       fileExistsMap;
+  TaskFormulaMap        taskFormula;
   bool                  activeTaskUseSerial0 = false;
+
+  // Sorted list of Domoticz idx values handled by tasks, used to filter received messages.
+  std::vector<unsigned int>  domoticzIdx;
+  controllerIndex_t          domoticzIdxControllerIndex = INVALID_CONTROLLER_INDEX;
+  bool                       domoticzIdxValid           = false;
+
+  // Pre-rendered JSON payload per task sent to Domoticz MQTT.
+  DomoticzPayloadTemplateMap domoticzPayloadTemplate;
+
+  ExtraTaskSettingsMap extraTaskSettings;
+  uint32_t             extraTaskSettingsUseCounter = 0;
+
+  // Templates used by parseTemplate() with their placeholders resolved.
+  ParsedTemplateCache parsedTemplates;
+
+  // Task values as last served by /json
+  JsonTaskValuesMap jsonTaskValues;
+
+  // Increased on every change of task values served by /json, never reset.
+  uint32_t jsonTaskValuesGeneration = 0;
+
+  PluginCommandTasksMap pluginCommandTasks;
+  uint32_t              pluginCommandTasksUseCounter = 0;
+
+private:
+
+  void updatePeriodicCallTasks();
+
+  // Not cleared when invalidated, as the lists may be iterated while a plugin changes task settings.
+  std::vector<taskIndex_t> fiftyPerSecondTasks;
+  std::vector<taskIndex_t> tenPerSecondTasks;
+  std::vector<taskIndex_t> oncePerSecondTasks;
+  bool                     periodicCallTasksValid = false;
 };
 
 
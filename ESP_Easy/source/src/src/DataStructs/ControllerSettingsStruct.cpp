@@ -29,6 +29,8 @@ void ControllerSettingsStruct::reset() {
   MustCheckReply             = false;
   SampleSetInitiator         = INVALID_TASK_INDEX;
   VariousFlags               = 0;
+  BatchSize                  = 0;
+  BatchFlushInterval         = 0;
 
   for (byte i = 0; i < 4; ++i) {
     IP[i] = 0;
@@ -59,6 +61,15 @@ void ControllerSettingsStruct::validate() {
 
   if (MaxQueueDepth > CONTROLLER_DELAY_QUEUE_DEPTH_MAX) { MaxQueueDepth = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT; }
 
+  if (!batchSettingsSet()) {
+    BatchSize          = 0;
+    BatchFlushInterval = 0;
+  }
+
+  if (BatchSize > CONTROLLER_DELAY_QUEUE_BATCH_MAX) { BatchSize = 0; }
+
+  if (BatchFlushInterval > CONTROLLER_DELAY_QUEUE_FLUSH_MAX) { BatchFlushInterval = 0; }
+
   if (MaxRetry > CONTROLLER_DELAY_QUEUE_RETRY_MAX) { MaxRetry = CONTROLLER_DELAY_QUEUE_RETRY_MAX; }
 
   if (MaxQueueDepth == 0) { MaxQueueDepth = CONTROLLER_DELAY_QUEUE_DEPTH_DFLT; }
@@ -255,3 +266,13 @@ void ControllerSettingsStruct::sendBinary(bool value)
 {
   bitWrite(VariousFlags, 7, value);
 }
+
+bool ControllerSettingsStruct::batchSettingsSet() const
+{
+  return bitRead(VariousFlags, 8);
+}
+
+void ControllerSettingsStruct::batchSettingsSet(bool value)
+{
+  bitWrite(VariousFlags, 8, value);
+}
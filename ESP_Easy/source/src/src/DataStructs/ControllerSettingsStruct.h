@@ -40,6 +40,16 @@ class WiFiUDP;
 # define CONTROLLER_DELAY_QUEUE_RETRY_DFLT  10
 #endif // ifndef CONTROLLER_DELAY_QUEUE_RETRY_DFLT
 
+// Max. number of queued messages a controller may send at once.
+#ifndef CONTROLLER_DELAY_QUEUE_BATCH_MAX
+# define CONTROLLER_DELAY_QUEUE_BATCH_MAX   25
+#endif // ifndef CONTROLLER_DELAY_QUEUE_BATCH_MAX
+
+// Max. time in msec to wait for a batch of messages to fill up.
+#ifndef CONTROLLER_DELAY_QUEUE_FLUSH_MAX
+# define CONTROLLER_DELAY_QUEUE_FLUSH_MAX   60000
+#endif // ifndef CONTROLLER_DELAY_QUEUE_FLUSH_MAX
+
 // Timeout of the client in msec.
 #ifndef CONTROLLER_CLIENTTIMEOUT_MAX
 # define CONTROLLER_CLIENTTIMEOUT_MAX     4000 // Not sure if this may trigger SW watchdog.
@@ -84,6 +94,8 @@ struct ControllerSettingsStruct
     CONTROLLER_TIMEOUT,
     CONTROLLER_SAMPLE_SET_INITIATOR,
     CONTROLLER_SEND_BINARY,
+    CONTROLLER_BATCH_SIZE,
+    CONTROLLER_BATCH_FLUSH_INTERVAL,
 
     // Keep this as last, is used to loop over all parameters
     CONTROLLER_ENABLED
@@ -134,6 +146,11 @@ struct ControllerSettingsStruct
   bool      sendBinary() const;
   void      sendBinary(bool value);
 
+  // BatchSize and BatchFlushInterval use bytes which were not initialized in older settings files.
+  // They are only considered valid when this flag is set.
+  bool      batchSettingsSet() const;
+  void      batchSettingsSet(bool value);
+
   boolean      UseDNS;
   byte         IP[4];
   unsigned int Port;
@@ -152,6 +169,8 @@ struct ControllerSettingsStruct
   taskIndex_t  SampleSetInitiator; // The first task to start a sample set.
   uint32_t     VariousFlags;       // Various flags
   char         ClientID[65];       // Used to define the Client ID used by the controller
+  uint8_t      BatchSize;          // Max. number of queued messages sent at once, 0 or 1 = no batching
+  uint16_t     BatchFlushInterval; // Max. time in msec to wait for a batch to fill up, 0 = send immediately
 
 private:
 
@@ -83,6 +83,11 @@ struct DeviceStruct
   bool TimerOption        : 1;       // Allow to set the "Interval" timer for the plugin.
   bool TimerOptional      : 1;       // When taskdevice timer is not set and not optional, use default "Interval" delay (Settings.Delay)
   bool DecimalsOnly       : 1;       // Allow to set the number of decimals (otherwise treated a 0 decimals)
+
+  // Periodic calls handled by the plugin. Only tasks of plugins which set these will be called.
+  bool FiftyPerSecond     : 1;       // PLUGIN_FIFTY_PER_SECOND
+  bool TenPerSecond       : 1;       // PLUGIN_TEN_PER_SECOND
+  bool OncePerSecond      : 1;       // PLUGIN_ONCE_A_SECOND
 };
 typedef std::vector<DeviceStruct> DeviceVector;
 
@@ -1,28 +1,214 @@
 #include "EventQueue.h"
 
-EventQueueStruct::EventQueueStruct() {}
+#include "../ESPEasyCore/ESPEasy_Log.h"
+#include "../Helpers/ESPEasy_time_calc.h"
+
+#include <utility>
+
+EventQueueStruct::EventQueueStruct() :
+  _head(0), _count(0), _policy(EVENT_QUEUE_OVERFLOW_POLICY),
+  _maxCount(0), _dropCount(0), _coalesceCount(0),
+  _dropCountLogged(0), _lastDropLog(0)
+{
+  for (uint16_t i = 0; i < EVENT_QUEUE_MAX; ++i) {
+    _taskValueEvent[i] = false;
+  }
+}
 
 void EventQueueStruct::add(const String& event)
 {
-  _eventQueue.push_back(event);
+  addEvent(event, false);
+}
+
+void EventQueueStruct::addTaskValueEvent(const String& event, bool replace)
+{
+  if (!replace || !replaceSameEventName(event)) {
+    addEvent(event, true);
+  }
+}
+
+void EventQueueStruct::addEvent(const String& event, bool taskValueEvent)
+{
+  if (_count >= EVENT_QUEUE_MAX) {
+    switch (_policy) {
+      case EventQueueOverflowPolicy::DropNewest:
+        eventDropped(event);
+        return;
+      case EventQueueOverflowPolicy::Coalesce:
+
+        if (taskValueEvent && replaceSameEventName(event)) {
+          return;
+        }
+
+        // Task values are sent periodically, so an older task value is dropped
+        // before any other event.
+        if (!removeOldestTaskValueEvent()) {
+          eventDropped(event);
+          return;
+        }
+        break;
+      case EventQueueOverflowPolicy::DropOldest:
+        eventDropped(_events[_head]);
+        _head = getSlot(1);
+        --_count;
+        break;
+    }
+  }
+
+  // Assign to keep the allocated buffer of the slot when possible.
+  const uint16_t slot = getSlot(_count);
+
+  _events[slot]         = event;
+  _taskValueEvent[slot] = taskValueEvent;
+  ++_count;
+
+  if (_count > _maxCount) {
+    _maxCount = _count;
+  }
 }
 
 bool EventQueueStruct::getNext(String& event)
 {
-  if (_eventQueue.empty()) {
+  if (_count == 0) {
     return false;
   }
-  event = _eventQueue.front();
-  _eventQueue.pop_front();
+  std::swap(event, _events[_head]);
+  _head = getSlot(1);
+  --_count;
   return true;
 }
 
 void EventQueueStruct::clear()
 {
-  _eventQueue.clear();
+  _head  = 0;
+  _count = 0;
 }
 
 bool EventQueueStruct::isEmpty() const
 {
-  return _eventQueue.empty();
-}
\ No newline at end of file
+  return _count == 0;
+}
+
+size_t EventQueueStruct::size() const
+{
+  return _count;
+}
+
+void EventQueueStruct::setOverflowPolicy(EventQueueOverflowPolicy policy)
+{
+  _policy = policy;
+}
+
+size_t EventQueueStruct::getMaxSize() const
+{
+  return _maxCount;
+}
+
+unsigned long EventQueueStruct::getDropCount() const
+{
+  return _dropCount;
+}
+
+unsigned long EventQueueStruct::getCoalesceCount() const
+{
+  return _coalesceCount;
+}
+
+String EventQueueStruct::getQueueStats() const
+{
+  String result;
+
+  result.reserve(48);
+  result += _count;
+  result += '/';
+  result += EVENT_QUEUE_MAX;
+  result += F(" (max: ");
+  result += _maxCount;
+  result += F(" dropped: ");
+  result += _dropCount;
+  result += F(" coalesced: ");
+  result += _coalesceCount;
+  result += ')';
+  return result;
+}
+
+uint16_t EventQueueStruct::getSlot(uint16_t index) const
+{
+  return (_head + index) % EVENT_QUEUE_MAX;
+}
+
+bool EventQueueStruct::replaceSameEventName(const String& event)
+{
+  const int index = findSameEventName(event);
+
+  if (index < 0) {
+    return false;
+  }
+
+  // Replace the queued event, keeping its position in the queue.
+  _events[getSlot(index)] = event;
+  ++_coalesceCount;
+  return true;
+}
+
+bool EventQueueStruct::removeOldestTaskValueEvent()
+{
+  for (uint16_t i = 0; i < _count; ++i) {
+    if (_taskValueEvent[getSlot(i)]) {
+      eventDropped(_events[getSlot(i)]);
+
+      // Move the older events one slot up, keeping the String buffers for reuse.
+      for (uint16_t j = i; j > 0; --j) {
+        std::swap(_events[getSlot(j)], _events[getSlot(j - 1)]);
+        _taskValueEvent[getSlot(j)] = _taskValueEvent[getSlot(j - 1)];
+      }
+      _head = getSlot(1);
+      --_count;
+      return true;
+    }
+  }
+  return false;
+}
+
+void EventQueueStruct::eventDropped(const String& event)
+{
+  ++_dropCount;
+
+  if ((_lastDropLog == 0) || (timePassedSince(_lastDropLog) >= EVENT_QUEUE_DROP_LOG_INTERVAL)) {
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      String log = F("EVENT: Queue full, dropped ");
+      log += _dropCount - _dropCountLogged;
+      log += F(" event(s), last: ");
+      log += event;
+      addLog(LOG_LEVEL_ERROR, log);
+    }
+    _dropCountLogged = _dropCount;
+    _lastDropLog     = millis();
+
+    if (_lastDropLog == 0) { _lastDropLog = 1; }
+  }
+}
+
+int EventQueueStruct::findSameEventName(const String& event) const
+{
+  // Event name is the part before the '=', e.g. "Task#Value" in "Task#Value=12.3"
+  const int    pos        = event.indexOf('=');
+  const size_t nameLength = (pos < 0) ? event.length() : pos;
+
+  for (uint16_t i = 0; i < _count; ++i) {
+    if (!_taskValueEvent[getSlot(i)]) {
+      continue;
+    }
+    const String& queued = _events[getSlot(i)];
+
+    if ((queued.length() < nameLength) ||
+        ((queued.length() > nameLength) && (queued[nameLength] != '='))) {
+      continue;
+    }
+
+    if (strncasecmp(queued.c_str(), event.c_str(), nameLength) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
@@ -2,26 +2,100 @@
 #define DATASTRUCTS_EVENTQUEUE_H
 
 
-#include <list>
 #include "../../ESPEasy_common.h"
 
+#include "../CustomBuild/ESPEasyLimits.h"
 #include "../Globals/Plugins.h"
 
 
+// What to do when an event is added to a full queue.
+enum class EventQueueOverflowPolicy : uint8_t {
+  DropOldest, // Remove the oldest event to make room for the new one.
+  DropNewest, // Do not add the new event.
+  Coalesce    // Replace a queued task value event with the same name, else remove the oldest queued task value event.
+              // Only when no task value event is queued, the new event is not added.
+};
+
+#ifndef EVENT_QUEUE_OVERFLOW_POLICY
+  # define EVENT_QUEUE_OVERFLOW_POLICY  EventQueueOverflowPolicy::Coalesce
+#endif // ifndef EVENT_QUEUE_OVERFLOW_POLICY
+
+
+/*********************************************************************************************\
+* EventQueueStruct
+* Bounded ring buffer of rules events.
+* The String objects of the slots are kept, so their allocated buffers are reused
+* for new events and adding an event normally does not allocate memory.
+\*********************************************************************************************/
 struct EventQueueStruct {
   EventQueueStruct();
 
-  void add(const String& event);
+  void   add(const String& event);
+
+  // Add a task value event, e.g. "Task#Value=12.3".
+  // Only task value events are considered for coalescing, as other events with the same name
+  // (e.g. "Rules#Timer=1" and "Rules#Timer=2") must all be processed.
+  // When replace is set, a queued task value event with the same name is replaced,
+  // keeping its position in the queue.
+  void   addTaskValueEvent(const String& event,
+                           bool          replace);
+
+  // Move the oldest event out of the queue.
+  // The buffer of the given String is kept in the queue for reuse,
+  // so calling this with the same String object prevents allocations.
+  bool   getNext(String& event);
+
+  void   clear();
+
+  bool   isEmpty() const;
 
-  bool getNext(String& event);
+  size_t size() const;
 
-  void clear();
+  void   setOverflowPolicy(EventQueueOverflowPolicy policy);
 
-  bool isEmpty() const;
+  // Statistics
+  size_t        getMaxSize() const;
+  unsigned long getDropCount() const;
+  unsigned long getCoalesceCount() const;
+
+  // Format queue depth and counters for display
+  String        getQueueStats() const;
 
 private:
 
-  std::list<String>_eventQueue;
+  // Position in the ring buffer of the n-th queued event.
+  uint16_t getSlot(uint16_t index) const;
+
+  // Add the event, applying the overflow policy when the queue is full.
+  void    addEvent(const String& event,
+                   bool          taskValueEvent);
+
+  // Find the queued task value event with the same name as the given event.
+  // Return -1 when not found.
+  int     findSameEventName(const String& event) const;
+
+  // Replace the queued task value event with the same name.
+  // Return false when not found.
+  bool    replaceSameEventName(const String& event);
+
+  // Remove the oldest queued task value event.
+  // Return false when not found.
+  bool    removeOldestTaskValueEvent();
+
+  // Count the dropped event and log it, at most once per EVENT_QUEUE_DROP_LOG_INTERVAL.
+  void    eventDropped(const String& event);
+
+  String                   _events[EVENT_QUEUE_MAX];
+  bool                     _taskValueEvent[EVENT_QUEUE_MAX];
+  uint16_t                 _head;  // Slot of the oldest event
+  uint16_t                 _count; // Number of queued events
+  EventQueueOverflowPolicy _policy;
+
+  uint16_t      _maxCount;
+  unsigned long _dropCount;
+  unsigned long _coalesceCount;
+  unsigned long _dropCountLogged; // Value of _dropCount at the last log
+  unsigned long _lastDropLog;
 };
 
 
@@ -3,16 +3,24 @@
 
 #include <Arduino.h>
 #include "ESPEasy_EventStruct.h"
+#include "MQTT_inbound_message.h"
 
 struct EventStructCommandWrapper {
   EventStructCommandWrapper() : id(0) {}
 
   EventStructCommandWrapper(unsigned long i, const EventStruct& e) : id(i), event(e) {}
 
+  EventStructCommandWrapper(unsigned long i, const EventStruct& e, const MQTT_inbound_message_ptr_type& msg)
+    : id(i), event(e), mqttMessage(msg) {}
+
   unsigned long      id;
   String             cmd;
   String             line;
   EventStruct event;
+
+  // Received MQTT message, shared with other scheduled events handling the same message.
+  // While processing, topic and payload are temporarily moved into event.String1 and event.String2.
+  MQTT_inbound_message_ptr_type mqttMessage;
 };
 
 #endif // DATASTRUCTS_EVENTSTRUCTCOMMANDWRAPPER_H
\ No newline at end of file
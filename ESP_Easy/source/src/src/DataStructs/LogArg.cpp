@@ -0,0 +1,139 @@
+#include "../DataStructs/LogArg.h"
+
+#include "../Helpers/Convert.h"
+
+
+size_t LogArg::encode(uint8_t *buffer, size_t maxSize) const
+{
+  switch (type) {
+    case Type::None:
+      return 0;
+    case Type::Int:
+    case Type::UInt:
+    case Type::Float:
+    {
+      if (maxSize < 5) {
+        return 0;
+      }
+      buffer[0] = static_cast<uint8_t>(type);
+      memcpy(&buffer[1], &_value, 4);
+      return 5;
+    }
+    case Type::String:
+    {
+      if (maxSize < 2) {
+        return 0;
+      }
+      size_t length = strlen_P(_value.str);
+
+      if (length > LOG_ENTRY_MAX_STRING_LENGTH) {
+        length = LOG_ENTRY_MAX_STRING_LENGTH;
+      }
+
+      if (length > (maxSize - 2)) {
+        length = maxSize - 2;
+      }
+      buffer[0] = static_cast<uint8_t>(type);
+
+      // Must use PROGMEM aware functions here to process the string
+      memcpy_P(&buffer[1], _value.str, length);
+      buffer[length + 1] = 0;
+      return length + 2;
+    }
+  }
+  return 0;
+}
+
+LogArg LogArg::decode(const uint8_t *buffer, size_t size, size_t& pos)
+{
+  LogArg res;
+
+  if (pos >= size) {
+    return res;
+  }
+  const Type argType = static_cast<Type>(buffer[pos]);
+
+  switch (argType) {
+    case Type::None:
+      break;
+    case Type::Int:
+    case Type::UInt:
+    case Type::Float:
+
+      if ((pos + 5) <= size) {
+        res.type = argType;
+        memcpy(&res._value, &buffer[pos + 1], 4);
+        pos += 5;
+        return res;
+      }
+      break;
+    case Type::String:
+    {
+      size_t end = pos + 1;
+
+      while (end < size && buffer[end] != 0) {
+        ++end;
+      }
+
+      if (end < size) {
+        res.type       = argType;
+        res._value.str = reinterpret_cast<const char *>(&buffer[pos + 1]);
+        pos            = end + 1;
+        return res;
+      }
+      break;
+    }
+  }
+
+  // Invalid data, skip the rest of the buffer.
+  pos = size;
+  return res;
+}
+
+void LogArg::appendTo(String& str) const
+{
+  switch (type) {
+    case Type::None:
+      break;
+    case Type::Int:
+      str += static_cast<long>(_value.i);
+      break;
+    case Type::UInt:
+      str += static_cast<unsigned long>(_value.u);
+      break;
+    case Type::Float:
+      str += toString(_value.f, 2);
+      break;
+    case Type::String:
+      // Using the PROGMEM aware concat
+      str += reinterpret_cast<const __FlashStringHelper *>(_value.str);
+      break;
+  }
+}
+
+String formatLogMessage(LogFormat format, const LogArg args[], size_t nrArgs)
+{
+  const char *c = reinterpret_cast<const char *>(getLogFormatString(format));
+  String res;
+  size_t argNr = 0;
+
+  res.reserve(64);
+
+  // Must use PROGMEM aware functions here to process the format string
+  char ch = pgm_read_byte(c++);
+
+  while (ch != '\0') {
+    if ((ch == '{') && (pgm_read_byte(c) == '}')) {
+      ++c;
+
+      if (argNr < nrArgs) {
+        args[argNr].appendTo(res);
+        ++argNr;
+      }
+    } else {
+      res += ch;
+    }
+    ch = pgm_read_byte(c++);
+  }
+  return res;
+}
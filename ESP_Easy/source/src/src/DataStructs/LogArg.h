@@ -0,0 +1,98 @@
+#ifndef DATASTRUCTS_LOGARG_H
+#define DATASTRUCTS_LOGARG_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/LogFormat.h"
+
+#define LOG_ENTRY_MAX_ARGS          4
+#define LOG_ENTRY_MAX_PAYLOAD_SIZE  255 // Max. size of the encoded arguments of a log entry
+#define LOG_ENTRY_MAX_STRING_LENGTH 127 // Max. length of a single string argument in the log buffer
+
+/*********************************************************************************************\
+* LogArg
+* Argument of a structured log entry, see LogFormat.
+* Numerical values are stored as 4 bytes, strings are stored as a copy including the 0-terminator.
+* String arguments only keep a pointer, so a LogArg must not outlive the string it was created from.
+\*********************************************************************************************/
+struct LogArg {
+  enum class Type : uint8_t {
+    None,
+    Int,
+    UInt,
+    Float,
+    String
+  };
+
+  LogArg() : type(Type::None) {}
+
+  LogArg(int value) : type(Type::Int) {
+    _value.i = value;
+  }
+
+  LogArg(long value) : type(Type::Int) {
+    _value.i = value;
+  }
+
+  LogArg(unsigned int value) : type(Type::UInt) {
+    _value.u = value;
+  }
+
+  LogArg(unsigned long value) : type(Type::UInt) {
+    _value.u = value;
+  }
+
+  LogArg(float value) : type(Type::Float) {
+    _value.f = value;
+  }
+
+  LogArg(double value) : type(Type::Float) {
+    _value.f = value;
+  }
+
+  // Must be a 0-terminated string, may be stored in PROGMEM.
+  LogArg(const char *str) : type(Type::String) {
+    _value.str = str;
+  }
+
+  LogArg(const String& str) : type(Type::String) {
+    _value.str = str.c_str();
+  }
+
+  LogArg(const __FlashStringHelper *str) : type(Type::String) {
+    _value.str = reinterpret_cast<const char *>(str);
+  }
+
+  // Write the binary representation to the buffer.
+  // Strings are truncated to fit in maxSize.
+  // Returns the nr of bytes written, 0 when it does not fit.
+  size_t        encode(uint8_t *buffer,
+                       size_t   maxSize) const;
+
+  // Decode the argument stored at buffer[pos] and set pos to the next argument.
+  // String arguments will point into the buffer.
+  static LogArg decode(const uint8_t *buffer,
+                       size_t         size,
+                       size_t       & pos);
+
+  void          appendTo(String& str) const;
+
+  Type type;
+
+private:
+
+  union {
+    int32_t     i;
+    uint32_t    u;
+    float       f;
+    const char *str;
+  } _value;
+};
+
+// Replace each "{}" in the format string with the next argument.
+String formatLogMessage(LogFormat     format,
+                        const LogArg  args[],
+                        size_t        nrArgs);
+
+
+#endif // DATASTRUCTS_LOGARG_H
@@ -1,33 +1,25 @@
 #include "../DataStructs/LogStruct.h"
 
+#include "../DataStructs/TimingStats.h"
 #include "../Helpers/ESPEasy_time_calc.h"
 #include "../Helpers/StringConverter.h"
 
 
 
 void LogStruct::add(const byte loglevel, const char *line) {
-  write_idx = (write_idx + 1) % LOG_STRUCT_MESSAGE_LINES;
+  const LogArg arg(line);
 
-  if (write_idx == read_idx) {
-    // Buffer full, move read_idx to overwrite oldest entry.
-    read_idx = (read_idx + 1) % LOG_STRUCT_MESSAGE_LINES;
-  }
-  timeStamp[write_idx] = millis();
-  log_level[write_idx] = loglevel;
-
-  // Must use PROGMEM aware functions here to process line
-  unsigned linelength = strlen_P(line);
+  add(loglevel, LogFormat::Text, &arg, 1);
+}
 
-  if (linelength > LOG_STRUCT_MESSAGE_SIZE - 1) {
-    linelength = LOG_STRUCT_MESSAGE_SIZE - 1;
-  }
-  Message[write_idx] = "";
-  Message[write_idx].reserve(linelength);
+void LogStruct::add(const byte loglevel, LogFormat format, const LogArg args[], size_t nrArgs) {
+  uint8_t payload[LOG_ENTRY_MAX_PAYLOAD_SIZE];
+  size_t  payloadSize = 0;
 
-  const char* c = line;
-  for (unsigned i = 0; i < linelength; ++i) {
-    Message[write_idx] += static_cast<char>(pgm_read_byte(c++));
+  for (size_t i = 0; i < nrArgs; ++i) {
+    payloadSize += args[i].encode(&payload[payloadSize], sizeof(payload) - payloadSize);
   }
+  addEntry(loglevel, format, payload, payloadSize);
 }
 
 // Read the next item and append it to the given string.
@@ -36,8 +28,10 @@ bool LogStruct::get(String& output, const String& lineEnd) {
   lastReadTimeStamp = millis();
 
   if (!isEmpty()) {
-    read_idx = (read_idx + 1) % LOG_STRUCT_MESSAGE_LINES;
-    output  += formatLine(read_idx, lineEnd);
+    unsigned long timestamp;
+    byte loglevel;
+    const String message = readEntry(timestamp, loglevel);
+    output  += formatLine(timestamp, message, lineEnd);
   }
   return !isEmpty();
 }
@@ -49,9 +43,9 @@ String LogStruct::get_logjson_formatted(bool& logLinesAvailable, unsigned long&
   if (isEmpty()) {
     return "";
   }
-  read_idx  = (read_idx + 1) % LOG_STRUCT_MESSAGE_LINES;
-  timestamp = timeStamp[read_idx];
-  String output = logjson_formatLine(read_idx);
+  byte loglevel;
+  const String message = readEntry(timestamp, loglevel);
+  String output = logjson_formatLine(timestamp, message, loglevel);
 
   if (isEmpty()) { return output; }
   output           += ",\n";
@@ -60,7 +54,7 @@ String LogStruct::get_logjson_formatted(bool& logLinesAvailable, unsigned long&
 }
 
 bool LogStruct::isEmpty() {
-  return write_idx == read_idx;
+  return _nrEntries == 0;
 }
 
 bool LogStruct::logActiveRead() {
@@ -68,44 +62,170 @@ bool LogStruct::logActiveRead() {
   return timePassedSince(lastReadTimeStamp) < LOG_BUFFER_EXPIRE;
 }
 
-String LogStruct::formatLine(int index, const String& lineEnd) {
+size_t LogStruct::getEstimatedNrLines() const {
+  float avgSize = getAvgEntrySize();
+
+  if (avgSize < 1.0f) {
+    // Nothing read yet, assume a plain text line of 40 characters.
+    avgSize = LOG_STRUCT_ENTRY_HEADER_SIZE + 42;
+  }
+  return LOG_STRUCT_BUFFER_SIZE / avgSize;
+}
+
+size_t LogStruct::getMemorySize() const {
+  return _buffer.size();
+}
+
+size_t LogStruct::getUsedSize() const {
+  return _used;
+}
+
+size_t LogStruct::getNrEntries() const {
+  return _nrEntries;
+}
+
+float LogStruct::getAvgEntrySize() const {
+  if (_nrEntriesRead == 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(_entryBytesRead) / _nrEntriesRead;
+}
+
+float LogStruct::getAvgTextSize() const {
+  if (_nrEntriesRead == 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(_textBytesRead) / _nrEntriesRead;
+}
+
+void LogStruct::addEntry(const byte loglevel, LogFormat format, const uint8_t *payload, uint8_t payloadSize) {
+  const size_t entrySize = LOG_STRUCT_ENTRY_HEADER_SIZE + payloadSize;
+
+  if (_buffer.empty()) {
+    _buffer.resize(LOG_STRUCT_BUFFER_SIZE);
+  }
+
+  // Buffer full, remove oldest entries to make room.
+  while (!isEmpty() && ((_used + entrySize) > _buffer.size())) {
+    removeOldest();
+  }
+
+  if (entrySize > _buffer.size()) {
+    return;
+  }
+  const uint32_t timestamp = millis();
+  uint8_t header[LOG_STRUCT_ENTRY_HEADER_SIZE];
+
+  header[0] = payloadSize;
+  memcpy(&header[1], &timestamp, 4);
+  header[5] = loglevel;
+  header[6] = static_cast<uint8_t>(format);
+  write(header,  LOG_STRUCT_ENTRY_HEADER_SIZE);
+  write(payload, payloadSize);
+  ++_nrEntries;
+}
+
+String LogStruct::readEntry(unsigned long& timestamp, byte& loglevel) {
+  uint8_t header[LOG_STRUCT_ENTRY_HEADER_SIZE];
+
+  read(_readPos, header, LOG_STRUCT_ENTRY_HEADER_SIZE);
+
+  const uint8_t payloadSize = header[0];
+  uint32_t timestamp_u32;
+  memcpy(&timestamp_u32, &header[1], 4);
+  timestamp = timestamp_u32;
+  loglevel  = header[5];
+  const LogFormat format = static_cast<LogFormat>(header[6]);
+
+  uint8_t payload[LOG_ENTRY_MAX_PAYLOAD_SIZE];
+  read((_readPos + LOG_STRUCT_ENTRY_HEADER_SIZE) % _buffer.size(), payload, payloadSize);
+  removeOldest();
+
+  START_TIMER
+  LogArg args[LOG_ENTRY_MAX_ARGS];
+  size_t nrArgs = 0;
+  size_t pos    = 0;
+
+  while (pos < payloadSize && nrArgs < LOG_ENTRY_MAX_ARGS) {
+    args[nrArgs] = LogArg::decode(payload, payloadSize, pos);
+
+    if (args[nrArgs].type != LogArg::Type::None) {
+      ++nrArgs;
+    }
+  }
+  String message = formatLogMessage(format, args, nrArgs);
+  STOP_TIMER(LOG_FORMAT_ENTRY);
+
+  ++_nrEntriesRead;
+  _entryBytesRead += LOG_STRUCT_ENTRY_HEADER_SIZE + payloadSize;
+
+  // Size of the String object + its 0-terminated message + timestamp + log level.
+  _textBytesRead += sizeof(String) + message.length() + 1 + sizeof(unsigned long) + sizeof(byte);
+  return message;
+}
+
+void LogStruct::removeOldest() {
+  if (isEmpty()) {
+    return;
+  }
+  const size_t entrySize = LOG_STRUCT_ENTRY_HEADER_SIZE + _buffer[_readPos];
+
+  _readPos = (_readPos + entrySize) % _buffer.size();
+  _used   -= entrySize;
+  --_nrEntries;
+}
+
+void LogStruct::write(const uint8_t *data, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    _buffer[_writePos] = data[i];
+    _writePos          = (_writePos + 1) % _buffer.size();
+  }
+  _used += size;
+}
+
+void LogStruct::read(uint16_t pos, uint8_t *data, size_t size) const {
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = _buffer[pos];
+    pos     = (pos + 1) % _buffer.size();
+  }
+}
+
+String LogStruct::formatLine(unsigned long timestamp, const String& message, const String& lineEnd) {
   String output;
 
-  output += timeStamp[index];
+  output += timestamp;
   output += " : ";
-  output += Message[index];
+  output += message;
   output += lineEnd;
   return output;
 }
 
-String LogStruct::logjson_formatLine(int index) {
+String LogStruct::logjson_formatLine(unsigned long timestamp, const String& message, byte loglevel) {
   String output;
 
   output.reserve(LOG_STRUCT_MESSAGE_SIZE + 64);
   output  = "{";
-  output += to_json_object_value("timestamp", String(timeStamp[index]));
+  output += to_json_object_value("timestamp", String(timestamp));
   output += ",\n";
-  output += to_json_object_value("text",  Message[index]);
+  output += to_json_object_value("text",  message);
   output += ",\n";
-  output += to_json_object_value("level", String(log_level[index]));
+  output += to_json_object_value("level", String(loglevel));
   output += "}";
   return output;
 }
 
 void LogStruct::clearExpiredEntries() {
-  if (isEmpty()) {
+  if (_buffer.empty()) {
     return;
   }
 
   if (timePassedSince(lastReadTimeStamp) > LOG_BUFFER_EXPIRE) {
-    // Clear the entire log.
+    // Clear the entire log and free the buffer.
     // If web log is the only log active, it will not be checked again until it is read.
-    for (read_idx = 0; read_idx < LOG_STRUCT_MESSAGE_LINES; ++read_idx) {
-      Message[read_idx]   = String(); // Free also the reserved memory.
-      timeStamp[read_idx] = 0;
-      log_level[read_idx] = 0;
-    }
-    read_idx  = 0;
-    write_idx = 0;
+    std::vector<uint8_t>().swap(_buffer);
+    _readPos   = 0;
+    _writePos  = 0;
+    _used      = 0;
+    _nrEntries = 0;
   }
 }
@@ -5,26 +5,41 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/LogArg.h"
+
+#include <vector>
+
 /*********************************************************************************************\
  * LogStruct
+ * Ring buffer for the web log, storing the entries in a compact binary form:
+ * [payload size][timestamp][log level][format id][payload]
+ * The payload contains the encoded arguments of the log format (see LogArg).
+ * The message is only formatted when the entry is read.
+ * Plain text lines are stored using LogFormat::Text with a single string argument.
 \*********************************************************************************************/
 #define LOG_STRUCT_MESSAGE_SIZE 128
+#define LOG_STRUCT_ENTRY_HEADER_SIZE 7
 #ifdef ESP32
-  #define LOG_STRUCT_MESSAGE_LINES 30
+  #define LOG_STRUCT_BUFFER_SIZE  2048
   #define LOG_BUFFER_EXPIRE         30000  // Time after which a buffered log item is considered expired.
 #else
   #if defined(PLUGIN_BUILD_TESTING) || defined(PLUGIN_BUILD_DEV)
-    #define LOG_STRUCT_MESSAGE_LINES 10
+    #define LOG_STRUCT_BUFFER_SIZE   512
   #else
-    #define LOG_STRUCT_MESSAGE_LINES 15
+    #define LOG_STRUCT_BUFFER_SIZE  1024
   #endif
   #define LOG_BUFFER_EXPIRE         5000  // Time after which a buffered log item is considered expired.
 #endif
 
 struct LogStruct {
-    
+
     void add(const byte loglevel, const char *line);
 
+    void add(const byte    loglevel,
+             LogFormat     format,
+             const LogArg  args[],
+             size_t        nrArgs);
+
     // Read the next item and append it to the given string.
     // Returns whether new lines are available.
     bool get(String& output, const String& lineEnd);
@@ -35,22 +50,54 @@ struct LogStruct {
 
     bool logActiveRead();
 
+    // Estimate of the nr of lines fitting in the buffer, based on the entries read so far.
+    size_t getEstimatedNrLines() const;
+
+    // Nr of bytes allocated for the buffer.
+    size_t getMemorySize() const;
+
+    size_t getUsedSize() const;
+
+    size_t getNrEntries() const;
+
+    // Average size of the entries read so far, stored in the binary format.
+    float getAvgEntrySize() const;
+
+    // Average size the entries read so far would need when stored as String (including timestamp and log level).
+    float getAvgTextSize() const;
+
   private:
-    String formatLine(int index, const String& lineEnd);
+    void addEntry(const byte     loglevel,
+                  LogFormat      format,
+                  const uint8_t *payload,
+                  uint8_t        payloadSize);
+
+    // Remove the oldest entry and return its formatted message.
+    String readEntry(unsigned long& timestamp, byte& loglevel);
+
+    void removeOldest();
 
-    String logjson_formatLine(int index);
+    void write(const uint8_t *data, size_t size);
+
+    void read(uint16_t pos, uint8_t *data, size_t size) const;
+
+    String formatLine(unsigned long timestamp, const String& message, const String& lineEnd);
+
+    String logjson_formatLine(unsigned long timestamp, const String& message, byte loglevel);
 
     void clearExpiredEntries();
 
-    String Message[LOG_STRUCT_MESSAGE_LINES];
-    unsigned long timeStamp[LOG_STRUCT_MESSAGE_LINES] = {0};
-    int write_idx = 0;
-    int read_idx = 0;
+    std::vector<uint8_t> _buffer;
     unsigned long lastReadTimeStamp = 0;
-    byte log_level[LOG_STRUCT_MESSAGE_LINES] = {0};
-
+    uint32_t _nrEntriesRead = 0;
+    uint32_t _entryBytesRead = 0;
+    uint32_t _textBytesRead = 0;
+    uint16_t _readPos = 0;
+    uint16_t _writePos = 0;
+    uint16_t _used = 0;
+    uint16_t _nrEntries = 0;
 };
 
 
 
-#endif // DATASTRUCTS_LOGSTRUCT_H
\ No newline at end of file
+#endif // DATASTRUCTS_LOGSTRUCT_H
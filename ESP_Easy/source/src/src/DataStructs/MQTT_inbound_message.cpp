@@ -0,0 +1,17 @@
+#include "../DataStructs/MQTT_inbound_message.h"
+
+MQTT_inbound_message::MQTT_inbound_message(const char *c_topic, const byte *b_payload, unsigned int length)
+  : topic(c_topic)
+{
+  if ((length == 0) || payload.reserve(length)) {
+    for (unsigned int i = 0; i < length; ++i) {
+      payload += static_cast<char>(b_payload[i]);
+    }
+    _valid = (topic.length() != 0) || (c_topic == nullptr) || (c_topic[0] == 0);
+  }
+}
+
+bool MQTT_inbound_message::isValid() const
+{
+  return _valid;
+}
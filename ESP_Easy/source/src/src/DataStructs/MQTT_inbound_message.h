@@ -0,0 +1,34 @@
+#ifndef DATASTRUCTS_MQTT_INBOUND_MESSAGE_H
+#define DATASTRUCTS_MQTT_INBOUND_MESSAGE_H
+
+#include "../../ESPEasy_common.h"
+
+#include <memory> // For std::shared_ptr
+#include <new>    // std::nothrow
+
+/*********************************************************************************************\
+* MQTT_inbound_message
+* Topic and payload of a received MQTT message.
+* A single instance is shared among all scheduled events handling the same message
+* (controller and MQTT import tasks), so the message is only copied once from the
+* MQTT client buffer.
+\*********************************************************************************************/
+struct MQTT_inbound_message {
+  MQTT_inbound_message(const char   *c_topic,
+                       const byte   *b_payload,
+                       unsigned int  length);
+
+  // Check whether topic and payload could be allocated.
+  bool isValid() const;
+
+  String topic;
+  String payload;
+
+private:
+
+  bool _valid = false;
+};
+
+typedef std::shared_ptr<MQTT_inbound_message> MQTT_inbound_message_ptr_type;
+
+#endif // DATASTRUCTS_MQTT_INBOUND_MESSAGE_H
@@ -0,0 +1,91 @@
+#include "../DataStructs/ParsedTemplateCache.h"
+
+#include "../Helpers/CRC_functions.h"
+#include "../Helpers/Memory.h"
+
+
+size_t ParsedTemplateCache::ParsedTemplate::getMemorySize() const
+{
+  size_t res = placeholders.size() * sizeof(Placeholder);
+
+  for (auto it = placeholders.begin(); it != placeholders.end(); ++it) {
+    res += it->format.length();
+  }
+  return res;
+}
+
+const ParsedTemplateCache::ParsedTemplate * ParsedTemplateCache::get(const String& tmpl)
+{
+  auto it = _templates.find(tmpl);
+
+  if (it == _templates.end()) {
+    return nullptr;
+  }
+  it->second.lastUsed = ++_useCounter;
+  return &(it->second);
+}
+
+bool ParsedTemplateCache::seenBefore(const String& tmpl)
+{
+  const uint32_t crc = calc_CRC32(reinterpret_cast<const uint8_t *>(tmpl.c_str()), tmpl.length());
+
+  for (uint8_t i = 0; i < PARSED_TEMPLATE_CACHE_MAX_CANDIDATES; ++i) {
+    if (_candidates[i] == crc) {
+      _candidates[i] = 0;
+      return true;
+    }
+  }
+  _candidates[_nextCandidate] = crc;
+  _nextCandidate              = (_nextCandidate + 1) % PARSED_TEMPLATE_CACHE_MAX_CANDIDATES;
+  return false;
+}
+
+void ParsedTemplateCache::add(const String& tmpl, ParsedTemplate&& parsed)
+{
+  const size_t memSize = tmpl.length() + sizeof(ParsedTemplate) + parsed.getMemorySize();
+
+  // Make room by removing the least recently used templates.
+  while (!_templates.empty() &&
+         ((_templates.size() >= PARSED_TEMPLATE_CACHE_MAX_ENTRIES) ||
+          (FreeMem() < (memSize + PARSED_TEMPLATE_CACHE_MIN_FREE_MEM)))) {
+    auto lru = _templates.begin();
+
+    for (auto it = _templates.begin(); it != _templates.end(); ++it) {
+      if (it->second.lastUsed < lru->second.lastUsed) {
+        lru = it;
+      }
+    }
+    _templates.erase(lru);
+  }
+
+  if (FreeMem() < (memSize + PARSED_TEMPLATE_CACHE_MIN_FREE_MEM)) {
+    return;
+  }
+  parsed.lastUsed = ++_useCounter;
+  _templates[tmpl] = std::move(parsed);
+}
+
+void ParsedTemplateCache::clear()
+{
+  _templates.clear();
+
+  for (uint8_t i = 0; i < PARSED_TEMPLATE_CACHE_MAX_CANDIDATES; ++i) {
+    _candidates[i] = 0;
+  }
+  _nextCandidate = 0;
+}
+
+size_t ParsedTemplateCache::size() const
+{
+  return _templates.size();
+}
+
+size_t ParsedTemplateCache::getMemorySize() const
+{
+  size_t res = 0;
+
+  for (auto it = _templates.begin(); it != _templates.end(); ++it) {
+    res += it->first.length() + sizeof(ParsedTemplate) + it->second.getMemorySize();
+  }
+  return res;
+}
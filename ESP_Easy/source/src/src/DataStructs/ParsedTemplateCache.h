@@ -0,0 +1,82 @@
+#ifndef DATASTRUCTS_PARSEDTEMPLATECACHE_H
+#define DATASTRUCTS_PARSEDTEMPLATECACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../CustomBuild/ESPEasyLimits.h"
+#include "../DataTypes/TaskIndex.h"
+
+#include <map>
+#include <vector>
+
+
+/*********************************************************************************************\
+* ParsedTemplateCache
+* Keeps templates used by parseTemplate() in a pre-split form.
+* The [...#...] placeholders of a template are located once and resolved to a
+* task/value index or variable number, so rendering the template only needs to
+* look up the values instead of scanning the string and searching task/value names.
+* The text in between the placeholders is kept in the template string itself,
+* which is also the key of the cache.
+* A template is only cached when it is seen for the second time, as many templates
+* are only used once (e.g. rules lines with a substituted %eventvalue%).
+\*********************************************************************************************/
+struct ParsedTemplateCache {
+  enum class PlaceholderType : uint8_t {
+    TaskValue,   // [taskname#valuename]
+    Variable,    // [var#N]
+    IntVariable, // [int#N]
+    Dynamic      // Plugin request, get config or unknown task, must be parsed when rendering
+  };
+
+  struct Placeholder {
+    Placeholder(uint16_t startPos, uint16_t endPos) : start(startPos), end(endPos) {}
+
+    uint16_t        start;                             // Position of '['
+    uint16_t        end;                               // Position of ']'
+    PlaceholderType type      = PlaceholderType::Dynamic;
+    taskIndex_t     taskIndex = INVALID_TASK_INDEX;
+    byte            valueNr   = VARS_PER_TASK;
+    unsigned int    varNum    = 0;
+    String          format;
+  };
+
+  struct ParsedTemplate {
+    size_t getMemorySize() const;
+
+    std::vector<Placeholder> placeholders;
+    uint32_t                 lastUsed               = 0;
+    bool                     hasSystemVariables     = false; // Template contains '%'
+    bool                     hasDynamicPlaceholders = false;
+  };
+
+  // Return nullptr when the template is not (yet) cached.
+  const ParsedTemplate* get(const String& tmpl);
+
+  // Remember a template which is not cached.
+  // Return true when it was seen recently, so it is worth caching.
+  bool                  seenBefore(const String& tmpl);
+
+  // Keep the parsed template.
+  // The least recently used templates are removed when the cache is full or free memory is low.
+  void                  add(const String   & tmpl,
+                            ParsedTemplate&& parsed);
+
+  void                  clear();
+
+  size_t                size() const;
+
+  size_t                getMemorySize() const;
+
+private:
+
+  std::map<String, ParsedTemplate> _templates;
+  uint32_t                         _useCounter = 0;
+
+  // CRC32 of the templates seen once.
+  uint32_t _candidates[PARSED_TEMPLATE_CACHE_MAX_CANDIDATES] = { 0 };
+  uint8_t  _nextCandidate                                     = 0;
+};
+
+
+#endif // DATASTRUCTS_PARSEDTEMPLATECACHE_H
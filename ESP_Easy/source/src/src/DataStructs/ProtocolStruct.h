@@ -31,6 +31,7 @@ struct ProtocolStruct
   bool     usesSampleSets : 1;
   bool     usesExtCreds   : 1;
   bool     needsNetwork   : 1;
+  bool     usesBatch      : 1; // When set, the controller can send multiple queued messages at once
 };
 
 typedef std::vector<ProtocolStruct> ProtocolVector;
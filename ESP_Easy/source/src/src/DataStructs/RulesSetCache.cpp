@@ -0,0 +1,297 @@
+#include "../DataStructs/RulesSetCache.h"
+
+#include "../DataStructs/TimingStats.h"
+#include "../ESPEasyCore/ESPEasyRules.h"
+#include "../ESPEasyCore/ESPEasy_Log.h"
+#include "../Helpers/ESPEasy_Storage.h"
+#include "../Helpers/Memory.h"
+
+
+void RulesSetCache::ParsedRulesSet::clear()
+{
+  lines = String();
+  lineStart.clear();
+  blocks.clear();
+  eventIndex.clear();
+  fallbackBlocks.clear();
+  state = State::NotParsed;
+}
+
+bool RulesSetCache::ParsedRulesSet::addLine(const String& line)
+{
+  const size_t start = lines.length();
+
+  if ((start + line.length() + 1) > 0xFFFF) {
+    // Offsets are stored as uint16_t
+    return false;
+  }
+
+  if (start != 0) {
+    lines += '\n';
+  }
+  lineStart.push_back(lines.length());
+  lines += line;
+  return true;
+}
+
+String RulesSetCache::ParsedRulesSet::getLine(uint16_t lineNr) const
+{
+  if (lineNr >= lineStart.size()) {
+    return F("");
+  }
+  const uint16_t start = lineStart[lineNr];
+  const uint16_t end   = (lineNr + 1u < lineStart.size()) ? lineStart[lineNr + 1] - 1 : lines.length();
+
+  return lines.substring(start, end);
+}
+
+void RulesSetCache::ParsedRulesSet::addToIndex(const String& trigger, uint16_t blockNr)
+{
+  String rule = trigger;
+
+  rule.trim();
+
+  if ((rule.indexOf('*') != -1) ||
+      rule.startsWith(F("!")) ||
+      (rule.indexOf('[') != -1) ||
+      (rule.indexOf('%') != -1) ||
+      (rule.indexOf('{') != -1)) {
+    // Wildcard, literal event or trigger which may change when parsing the template
+    fallbackBlocks.push_back(blockNr);
+    return;
+  }
+
+  // Key when matching the complete event string, e.g. "Rules#Timer=3"
+  const String eventKey = getEventIndexKey(rule);
+
+  eventIndex[eventKey].push_back(blockNr);
+
+  // Key when matching with a compare condition, e.g. "ph#value>7.2"
+  int  posStart, posEnd;
+  char compare;
+
+  if (findCompareCondition(rule, compare, posStart, posEnd)) {
+    String ruleKey = rule.substring(0, posStart);
+    ruleKey.trim();
+
+    if (!ruleKey.equals(eventKey)) {
+      eventIndex[ruleKey].push_back(blockNr);
+    }
+  }
+}
+
+void RulesSetCache::ParsedRulesSet::getCandidateBlocks(const String& event, std::vector<uint16_t>& candidates) const
+{
+  candidates.clear();
+
+  const std::vector<uint16_t> *indexed = nullptr;
+
+  if (event.charAt(0) != '!') {
+    auto it = eventIndex.find(getEventIndexKey(event));
+
+    if (it != eventIndex.end()) {
+      indexed = &(it->second);
+    }
+  }
+
+  if (indexed == nullptr) {
+    candidates = fallbackBlocks;
+    return;
+  }
+
+  // Merge both sorted lists to keep the order of the blocks in the rules set.
+  candidates.reserve(indexed->size() + fallbackBlocks.size());
+  auto it_i = indexed->begin();
+  auto it_f = fallbackBlocks.begin();
+
+  while (it_i != indexed->end() || it_f != fallbackBlocks.end()) {
+    if ((it_f == fallbackBlocks.end()) ||
+        ((it_i != indexed->end()) && (*it_i < *it_f))) {
+      candidates.push_back(*it_i);
+      ++it_i;
+    } else {
+      candidates.push_back(*it_f);
+      ++it_f;
+    }
+  }
+}
+
+size_t RulesSetCache::ParsedRulesSet::getMemorySize() const
+{
+  size_t res = lines.length() +
+               lineStart.size() * sizeof(uint16_t) +
+               blocks.size() * sizeof(Block) +
+               fallbackBlocks.size() * sizeof(uint16_t);
+
+  for (auto it = eventIndex.begin(); it != eventIndex.end(); ++it) {
+    res += it->first.length() + it->second.size() * sizeof(uint16_t);
+  }
+  return res;
+}
+
+String RulesSetCache::getEventIndexKey(const String& event)
+{
+  const int pos = event.indexOf('=');
+  String    key = (pos == -1) ? event : event.substring(0, pos);
+
+  key.trim();
+  key.toLowerCase();
+  return key;
+}
+
+RulesSetCache::RulesSetCache() : _inUse(0), _mustClear(false) {}
+
+void RulesSetCache::clear()
+{
+  if (_inUse != 0) {
+    _mustClear = true;
+    return;
+  }
+
+  for (byte x = 0; x < RULESETS_MAX; ++x) {
+    _rulesSets[x].clear();
+  }
+  _mustClear = false;
+}
+
+const RulesSetCache::ParsedRulesSet * RulesSetCache::get(byte rulesSet)
+{
+  if ((rulesSet >= RULESETS_MAX) || _mustClear) {
+    return nullptr;
+  }
+
+  if (_rulesSets[rulesSet].state == State::NotParsed) {
+    START_TIMER
+
+    if (!parse(rulesSet)) {
+      _rulesSets[rulesSet].clear();
+      _rulesSets[rulesSet].state = State::NotCacheable;
+    }
+    STOP_TIMER(RULES_PARSE_SET);
+  }
+
+  if (_rulesSets[rulesSet].state != State::Parsed) {
+    return nullptr;
+  }
+  return &_rulesSets[rulesSet];
+}
+
+void RulesSetCache::claim()
+{
+  ++_inUse;
+}
+
+void RulesSetCache::release()
+{
+  if (_inUse > 0) {
+    --_inUse;
+  }
+
+  if ((_inUse == 0) && _mustClear) {
+    clear();
+  }
+}
+
+size_t RulesSetCache::getMemorySize() const
+{
+  size_t res = 0;
+
+  for (byte x = 0; x < RULESETS_MAX; ++x) {
+    res += _rulesSets[x].getMemorySize();
+  }
+  return res;
+}
+
+bool RulesSetCache::parse(byte rulesSet)
+{
+  ParsedRulesSet& parsed = _rulesSets[rulesSet];
+
+  parsed.clear();
+
+  const String fileName = getRulesSetFileName(rulesSet);
+  size_t fileSize       = 0;
+  {
+    fs::File f = tryOpenFile(fileName, "r");
+
+    if (!f) {
+      return false;
+    }
+    fileSize = f.size();
+    f.close();
+  }
+
+  // The parsed rules set is never larger than the file itself,
+  // so only keep it in RAM when there is enough free memory left.
+  if ((fileSize >= 0xFFFF) || (FreeMem() < (fileSize + RULES_CACHE_MIN_FREE_MEM))) {
+    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      String log = F("Rules : Not enough memory to cache ");
+      log += fileName;
+      addLog(LOG_LEVEL_INFO, log);
+    }
+    return false;
+  }
+  parsed.lines.reserve(fileSize);
+
+  bool codeBlock = false;
+  bool success   = true;
+  uint16_t lineNr = 0;
+
+  rulesReadFileLines(fileName, [&](String& line)
+  {
+    if (!success) { return; }
+
+    String lcLine = line;
+    rules_strip_trailing_comments(lcLine);
+    lcLine.toLowerCase();
+
+    if (!codeBlock && lcLine.startsWith(F("on "))) {
+      // Start of a new "on ... do" block.
+      // When there is no action on the same line, the block ends with "endon"
+      parsed.blocks.emplace_back(lineNr);
+      const int split = lcLine.indexOf(F(" do"));
+
+      if (split == -1) {
+        codeBlock = true;
+        parsed.addToIndex(lcLine.substring(3), parsed.blocks.size() - 1);
+      } else {
+        String action = lcLine.substring(split + 4);
+        action.trim();
+        codeBlock = action.length() == 0;
+        parsed.addToIndex(lcLine.substring(3, split), parsed.blocks.size() - 1);
+      }
+    } else if (parsed.blocks.empty()) {
+      // Lines outside an "on ... do" block are never processed.
+      return;
+    } else {
+      ++(parsed.blocks.back().nrLines);
+
+      if (codeBlock && lcLine.equals(F("endon"))) {
+        codeBlock = false;
+      }
+    }
+
+    if (!parsed.addLine(line)) {
+      success = false;
+      return;
+    }
+    ++lineNr;
+  });
+
+  if (!success) {
+    return false;
+  }
+  parsed.state = State::Parsed;
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    String log = F("Rules : Cached ");
+    log += fileName;
+    log += F(" blocks: ");
+    log += parsed.blocks.size();
+    log += F(" indexed: ");
+    log += parsed.eventIndex.size();
+    log += F(" bytes: ");
+    log += parsed.getMemorySize();
+    addLog(LOG_LEVEL_INFO, log);
+  }
+  return true;
+}
@@ -0,0 +1,98 @@
+#ifndef DATASTRUCTS_RULESSETCACHE_H
+#define DATASTRUCTS_RULESSETCACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../CustomBuild/ESPEasyLimits.h"
+
+#include <map>
+#include <vector>
+
+
+/*********************************************************************************************\
+* RulesSetCache
+* Keeps the rules files (rules1.txt ... rules4.txt) in RAM in a pre-parsed form.
+* Each rules set is parsed once into cleaned lines (no indentation, no comment lines)
+* grouped per "on ... do" block, so processing an event does not need to read
+* and tokenize the rules file from flash.
+* An index on event name is kept to only process the blocks which may match an event.
+\*********************************************************************************************/
+struct RulesSetCache {
+  // Range of lines belonging to a single "on ... do" block.
+  // The first line is always the "on ... do" line.
+  struct Block {
+    Block(uint16_t first) : firstLine(first), nrLines(1) {}
+
+    uint16_t firstLine;
+    uint16_t nrLines;
+  };
+
+  enum class State : uint8_t {
+    NotParsed,
+    Parsed,
+    NotCacheable // File too large or not enough free memory, must read from file.
+  };
+
+  // Index from event name to the blocks which may match that event.
+  typedef std::map<String, std::vector<uint16_t> > EventBlockIndexMap;
+
+  struct ParsedRulesSet {
+    void     clear();
+
+    bool     addLine(const String& line);
+
+    String   getLine(uint16_t lineNr) const;
+
+    // Add the block to the event index, based on the trigger of its "on ... do" line.
+    void     addToIndex(const String& trigger,
+                        uint16_t      blockNr);
+
+    // Collect (in order of appearance) the blocks which may match the event.
+    void     getCandidateBlocks(const String         & event,
+                                std::vector<uint16_t>& candidates) const;
+
+    size_t   getMemorySize() const;
+
+    // All lines, separated by '\n'
+    String                lines;
+    std::vector<uint16_t> lineStart;
+    std::vector<Block>    blocks;
+    EventBlockIndexMap    eventIndex;
+
+    // Blocks with a trigger which cannot be indexed by event name.
+    // (wildcards, literal '!' events or triggers with variables)
+    std::vector<uint16_t> fallbackBlocks;
+    State                 state = State::NotParsed;
+  };
+
+  // Normalized event name used as key in the event index.
+  // e.g. "Clock#Time=Sun,12:00" => "clock#time"
+  static String getEventIndexKey(const String& event);
+
+  RulesSetCache();
+
+  // Remove all parsed rules sets.
+  // When a rules set is being processed, clearing is postponed until processing has finished.
+  void                  clear();
+
+  // Parse the rules set if not yet done.
+  // Returns nullptr when the rules set cannot be used from the cache.
+  const ParsedRulesSet* get(byte rulesSet);
+
+  // Mark the cache as in use to prevent clearing it while iterating over the parsed lines.
+  void                  claim();
+  void                  release();
+
+  size_t                getMemorySize() const;
+
+private:
+
+  bool parse(byte rulesSet);
+
+  ParsedRulesSet _rulesSets[RULESETS_MAX];
+  uint8_t        _inUse;
+  bool           _mustClear;
+};
+
+
+#endif // DATASTRUCTS_RULESSETCACHE_H
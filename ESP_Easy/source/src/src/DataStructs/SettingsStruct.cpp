@@ -161,6 +161,19 @@ void SettingsStruct_tmpl<N_TASKS>::CombineTaskValues_SingleEvent(taskIndex_t tas
     bitWrite(TaskDeviceSendDataFlags[taskIndex], 0, value);
 }
 
+template<unsigned int N_TASKS>
+bool SettingsStruct_tmpl<N_TASKS>::CoalesceTaskValueEvents(taskIndex_t taskIndex) const {
+  if (validTaskIndex(taskIndex))
+    return bitRead(TaskDeviceSendDataFlags[taskIndex], 1);
+  return false;
+}
+
+template<unsigned int N_TASKS>
+void SettingsStruct_tmpl<N_TASKS>::CoalesceTaskValueEvents(taskIndex_t taskIndex, bool value) {
+  if (validTaskIndex(taskIndex))
+    bitWrite(TaskDeviceSendDataFlags[taskIndex], 1, value);
+}
+
 template<unsigned int N_TASKS>
 void SettingsStruct_tmpl<N_TASKS>::validate() {
   if (UDPPort > 65535) { UDPPort = 0; }
@@ -104,6 +104,10 @@ class SettingsStruct_tmpl
   bool CombineTaskValues_SingleEvent(taskIndex_t taskIndex) const;
   void CombineTaskValues_SingleEvent(taskIndex_t taskIndex, bool value);
 
+  // Flag indicating whether a new task value event replaces a still queued event of the same task value
+  bool CoalesceTaskValueEvents(taskIndex_t taskIndex) const;
+  void CoalesceTaskValueEvents(taskIndex_t taskIndex, bool value);
+
   void validate();
 
   bool networkSettingsEmpty() const;
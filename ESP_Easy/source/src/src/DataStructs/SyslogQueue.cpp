@@ -0,0 +1,197 @@
+#include "../DataStructs/SyslogQueue.h"
+
+#include "../DataStructs/TimingStats.h"
+#include "../ESPEasyCore/ESPEasy_Log.h"
+#include "../ESPEasyCore/ESPEasyNetwork.h"
+#include "../Globals/NetworkState.h"
+#include "../Globals/Settings.h"
+#include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/Memory.h"
+
+#include <IPAddress.h>
+
+
+bool SyslogQueue::add(byte logLevel, const char *line)
+{
+  if (Settings.Syslog_IP[0] == 0) {
+    return false;
+  }
+
+  // Must use PROGMEM aware functions here to process line
+  const size_t length = strlen_P(line);
+
+  if (((_buffer.size() + length + 2) > SYSLOG_QUEUE_MAX_SIZE) ||
+      (FreeMem() < SYSLOG_QUEUE_MIN_FREE_MEM)) {
+    ++_linesDropped;
+    ++_droppedPending;
+    return false;
+  }
+  _buffer.push_back(static_cast<char>(logLevel));
+
+  const char *c = line;
+
+  for (size_t i = 0; i < length; ++i) {
+    _buffer.push_back(pgm_read_byte(c++));
+  }
+  _buffer.push_back('\0');
+  return true;
+}
+
+void SyslogQueue::process()
+{
+  if (_buffer.empty() && (_droppedPending == 0)) {
+    return;
+  }
+
+  if (Settings.Syslog_IP[0] == 0) {
+    clear();
+    return;
+  }
+
+  if ((_lastSend != 0) && (timePassedSince(_lastSend) < SYSLOG_SEND_INTERVAL)) {
+    return;
+  }
+
+  if (!NetworkConnected()) {
+    // Keep the lines until the network is available again.
+    // When the buffer is full, new lines will be dropped.
+    return;
+  }
+  START_TIMER
+  _lastSend = millis();
+
+  IPAddress syslogIP(Settings.Syslog_IP[0], Settings.Syslog_IP[1], Settings.Syslog_IP[2], Settings.Syslog_IP[3]);
+
+  if (portUDP.beginPacket(syslogIP, Settings.SyslogPort) == 0) {
+    // problem resolving the hostname or port, try again after the send interval
+    return;
+  }
+
+  // An RFC3164 compliant message must be formated like :  "<PRIO>[TimeStamp ]Hostname TaskName: Message"
+  if (_header.length() == 0) {
+    // Using Settings.Name as the Hostname (Hostname must NOT contain space)
+    String hostname = NetworkCreateRFCCompliantHostname(true);
+    hostname.trim();
+    hostname.replace(' ', '_');
+    _header.reserve(hostname.length() + 10);
+    _header  = hostname;
+    _header += F(" EspEasy: ");
+  }
+
+  String packet;
+
+  packet.reserve(SYSLOG_MAX_PACKET_SIZE);
+  unsigned int nrLines = 0;
+
+  if (_droppedPending != 0) {
+    appendHeader(packet, LOG_LEVEL_ERROR);
+    packet += F("Syslog: ");
+    packet += _droppedPending;
+    packet += F(" lines dropped");
+    ++nrLines;
+  }
+
+  while (!_buffer.empty() && (nrLines < SYSLOG_MAX_LINES_PER_PACKET)) {
+    const size_t lineEnd = getFirstLineEnd();
+
+    // Max. size of the header: "<191>" + '\n'
+    const size_t lineSize = lineEnd + _header.length() + 6;
+
+    if ((nrLines != 0) && ((packet.length() + lineSize) > SYSLOG_MAX_PACKET_SIZE)) {
+      break;
+    }
+
+    if (nrLines != 0) {
+      packet += '\n';
+    }
+    appendHeader(packet, static_cast<byte>(_buffer[0]));
+
+    for (size_t i = 1; i < lineEnd; ++i) {
+      packet += _buffer[i];
+    }
+    _buffer.erase(_buffer.begin(), _buffer.begin() + lineEnd + 1);
+    ++nrLines;
+  }
+
+  portUDP.write(reinterpret_cast<const uint8_t *>(packet.c_str()), packet.length());
+  portUDP.endPacket();
+
+  if (_droppedPending != 0) {
+    // The "lines dropped" line is not counted as a sent line.
+    --nrLines;
+    _droppedPending = 0;
+  }
+  _linesSent += nrLines;
+  ++_packetsSent;
+  STOP_TIMER(SYSLOG_SEND);
+}
+
+void SyslogQueue::clear()
+{
+  _buffer.clear();
+  _droppedPending = 0;
+}
+
+void SyslogQueue::clearHeaderCache()
+{
+  _header = String();
+}
+
+bool SyslogQueue::isEmpty() const
+{
+  return _buffer.empty();
+}
+
+size_t SyslogQueue::size() const
+{
+  return _buffer.size();
+}
+
+String SyslogQueue::getQueueStats() const
+{
+  String res;
+
+  res.reserve(80);
+  res += _buffer.size();
+  res += F(" bytes, sent: ");
+  res += _linesSent;
+  res += F(" lines in ");
+  res += _packetsSent;
+  res += F(" packets, dropped: ");
+  res += _linesDropped;
+  return res;
+}
+
+size_t SyslogQueue::getFirstLineEnd() const
+{
+  size_t pos = 1; // Skip the log level
+
+  while (pos < _buffer.size() && _buffer[pos] != '\0') {
+    ++pos;
+  }
+  return pos;
+}
+
+void SyslogQueue::appendHeader(String& packet, byte logLevel) const
+{
+  packet += '<';
+  packet += getPrio(logLevel);
+  packet += '>';
+  packet += _header;
+}
+
+byte SyslogQueue::getPrio(byte logLevel)
+{
+  byte prio = Settings.SyslogFacility * 8;
+
+  if (logLevel == LOG_LEVEL_ERROR) {
+    prio += 3; // syslog error
+  }
+  else if (logLevel == LOG_LEVEL_INFO) {
+    prio += 5; // syslog notice
+  }
+  else {
+    prio += 7;
+  }
+  return prio;
+}
@@ -0,0 +1,65 @@
+#ifndef DATASTRUCTS_SYSLOGQUEUE_H
+#define DATASTRUCTS_SYSLOGQUEUE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../CustomBuild/ESPEasyLimits.h"
+
+#include <deque>
+
+
+/*********************************************************************************************\
+* SyslogQueue
+* Buffer for log lines to be sent to the syslog server.
+* Adding a line only copies it into the buffer, the lines are sent from backgroundtasks().
+* Each line is sent as a separate UDP packet, unless SYSLOG_MAX_LINES_PER_PACKET is set > 1
+* to pack multiple lines into a single packet, separated by '\n'.
+* Each line is formatted as an RFC3164 message: "<PRIO>Hostname EspEasy: Message"
+* The "Hostname EspEasy: " part is computed once and kept until clearHeaderCache() is called.
+*
+* Lines are stored as: [log level][message chars]['\0']
+\*********************************************************************************************/
+struct SyslogQueue {
+  // Copy the (PROGMEM aware) line to the buffer.
+  // Returns false when the line was dropped because the buffer is full.
+  bool   add(byte        logLevel,
+             const char *line);
+
+  // Send a packet with queued lines, if the send interval has passed.
+  void   process();
+
+  // Remove all queued lines.
+  void   clear();
+
+  // Must be called when the hostname may have changed.
+  void   clearHeaderCache();
+
+  bool   isEmpty() const;
+
+  // Nr of bytes currently queued.
+  size_t size() const;
+
+  String getQueueStats() const;
+
+private:
+
+  // Position of the '\0' terminating the first line in the buffer.
+  size_t getFirstLineEnd() const;
+
+  // Append "<PRIO>Hostname EspEasy: " to the packet.
+  void   appendHeader(String& packet,
+                      byte    logLevel) const;
+
+  static byte getPrio(byte logLevel);
+
+  std::deque<char> _buffer;
+  String           _header;
+  unsigned long    _lastSend       = 0;
+  uint32_t         _linesSent      = 0;
+  uint32_t         _packetsSent    = 0;
+  uint32_t         _linesDropped   = 0;
+  uint32_t         _droppedPending = 0; // Nr. of dropped lines not yet reported to the syslog server
+};
+
+
+#endif // DATASTRUCTS_SYSLOGQUEUE_H
@@ -79,6 +79,7 @@ String getPluginFunctionName(int function) {
     case PLUGIN_WEBFORM_LOAD:          return F("WEBFORM_LOAD");
     case PLUGIN_WEBFORM_SHOW_VALUES:   return F("WEBFORM_SHOW_VALUES");
     case PLUGIN_FORMAT_USERVAR:        return F("FORMAT_USERVAR");
+    case PLUGIN_GET_COMMANDS:          return F("GET_COMMANDS");
     case PLUGIN_GET_DEVICENAME:        return F("GET_DEVICENAME");
     case PLUGIN_GET_DEVICEVALUENAMES:  return F("GET_DEVICEVALUENAMES");
     case PLUGIN_WRITE:                 return F("WRITE");
@@ -112,6 +113,7 @@ bool mustLogFunction(int function) {
     case PLUGIN_WEBFORM_LOAD:          return false;
     case PLUGIN_WEBFORM_SHOW_VALUES:   return false;
     case PLUGIN_FORMAT_USERVAR:        return false;
+    case PLUGIN_GET_COMMANDS:          return false;
     case PLUGIN_GET_DEVICENAME:        return false;
     case PLUGIN_GET_DEVICEVALUENAMES:  return false;
     case PLUGIN_WRITE:                 return true;
@@ -206,6 +208,8 @@ String getMiscStatsName(int stat) {
     case SENSOR_SEND_TASK:        return F("SensorSendTask()");
     case SEND_DATA_STATS:         return F("sendData()");
     case COMPUTE_FORMULA_STATS:   return F("Compute formula");
+    case COMPILE_FORMULA_STATS:   return F("Compile formula");
+    case RULES_CALCULATE_STATS:   return F("Calculate()");
     case PROC_SYS_TIMER:          return F("proc_system_timer()");
     case SET_NEW_TIMER:           return F("setNewTimerAt()");
     case TIME_DIFF_COMPUTE:       return F("timeDiff()");
@@ -218,18 +222,29 @@ String getMiscStatsName(int stat) {
     case WIFI_ISCONNECTED_STATS:  return F("WiFi.isConnected()");
     case WIFI_NOTCONNECTED_STATS: return F("WiFi.isConnected() (fail)");
     case LOAD_TASK_SETTINGS:      return F("LoadTaskSettings()");
+    case LOAD_TASK_SETTINGS_CACHED: return F("LoadTaskSettings() cached");
     case TRY_OPEN_FILE:           return F("TryOpenFile()");
     case FS_GC_SUCCESS:           return F("ESPEASY_FS GC success");
     case FS_GC_FAIL:              return F("ESPEASY_FS GC fail");
     case RULES_PROCESSING:        return F("rulesProcessing()");
+    case RULES_PARSE_SET:         return F("Rules parse set");
     case GRAT_ARP_STATS:          return F("sendGratuitousARP()");
     case BACKGROUND_TASKS:        return F("backgroundtasks()");
     case HANDLE_SCHEDULER_IDLE:   return F("handle_schedule() idle");
     case HANDLE_SCHEDULER_TASK:   return F("handle_schedule() task");
     case PARSE_TEMPLATE_PADDED:   return F("parseTemplate_padded()");
+    case PARSE_TEMPLATE_CACHED:   return F("parseTemplate_padded() cached");
     case PARSE_SYSVAR:            return F("parseSystemVariables()");
     case PARSE_SYSVAR_NOCHANGE:   return F("parseSystemVariables() No change");
     case HANDLE_SERVING_WEBPAGE:  return F("handle webpage");
+    case HANDLE_SERVING_JSON:     return F("handle_json()");
+    case MODBUS_RTU_SEND:         return F("Modbus RTU send frame");
+    case MODBUS_RTU_TRANSACTION:  return F("Modbus RTU transaction");
+    case PLUGIN_CALL_WRITE:       return F("PluginCall(PLUGIN_WRITE)");
+    case SYSLOG_SEND:             return F("Syslog send packet");
+    case ADD_LOG_TEXT:            return F("addToLog() text");
+    case ADD_LOG_FORMAT:          return F("addToLog() structured");
+    case LOG_FORMAT_ENTRY:        return F("Format log entry");
     case C018_AIR_TIME:           return F("C018 LoRa TTN - Air Time");
     case C001_DELAY_QUEUE:
     case C002_DELAY_QUEUE:
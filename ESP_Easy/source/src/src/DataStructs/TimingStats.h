@@ -80,6 +80,19 @@
 # define HANDLE_SCHEDULER_IDLE   59
 # define HANDLE_SCHEDULER_TASK   60
 # define HANDLE_SERVING_WEBPAGE  61
+# define RULES_PARSE_SET         62
+# define COMPILE_FORMULA_STATS   63
+# define RULES_CALCULATE_STATS   64
+# define LOAD_TASK_SETTINGS_CACHED 65
+# define PARSE_TEMPLATE_CACHED   66
+# define HANDLE_SERVING_JSON     67
+# define MODBUS_RTU_SEND         68
+# define MODBUS_RTU_TRANSACTION  69
+# define PLUGIN_CALL_WRITE       70
+# define SYSLOG_SEND             71
+# define ADD_LOG_TEXT            72
+# define ADD_LOG_FORMAT          73
+# define LOG_FORMAT_ENTRY        74
 
 
 class TimingStats {
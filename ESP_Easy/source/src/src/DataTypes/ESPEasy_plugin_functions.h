@@ -8,8 +8,8 @@
 #define PLUGIN_INIT_ALL                     1 // Not implemented in a plugin, only called during boot
 #define PLUGIN_INIT                         2 // Init the task, called when task is set to enabled (also at boot)
 #define PLUGIN_READ                         3 // This call can yield new data (when success = true) and then send to controllers
-#define PLUGIN_ONCE_A_SECOND                4 // Called once a second
-#define PLUGIN_TEN_PER_SECOND               5 // Called 10x per second (typical for checking new data instead of waiting)
+#define PLUGIN_ONCE_A_SECOND                4 // Called once a second (only when Device[deviceCount].OncePerSecond is set)
+#define PLUGIN_TEN_PER_SECOND               5 // Called 10x per second (typical for checking new data instead of waiting, only when Device[deviceCount].TenPerSecond is set)
 #define PLUGIN_DEVICE_ADD                   6 // Called at boot for letting a plugin adding itself to list of available plugins/devices
 #define PLUGIN_EVENTLIST_ADD                7 // Not used.
 #define PLUGIN_WEBFORM_SAVE                 8 // Call from web interface to save settings
@@ -26,7 +26,7 @@
 #define PLUGIN_UDP_IN                      19 // Called for received UDP data via ESPEasy p2p which isn't a standard p2p packet. (See C013 for handling standard p2p packets)
 #define PLUGIN_CLOCK_IN                    20 // Called every new minute
 #define PLUGIN_TIMER_IN                    21 // Called with a previously defined event at a specific time, set via setPluginTaskTimer
-#define PLUGIN_FIFTY_PER_SECOND            22 // Called 50 times per second
+#define PLUGIN_FIFTY_PER_SECOND            22 // Called 50 times per second (only when Device[deviceCount].FiftyPerSecond is set)
 #define PLUGIN_SET_CONFIG                  23 // Counterpart of PLUGIN_GET_CONFIG to allow to set a config via a command.
 #define PLUGIN_GET_DEVICEGPIONAMES         24 // Allow for specific formatting of the label for standard pin configuration (e.g. "GPIO <- TX")
 #define PLUGIN_EXIT                        25 // Called when a task no longer is enabled (or deleted)
@@ -44,6 +44,8 @@
 #define PLUGIN_MQTT_CONNECTION_STATE       36 // Signal when connection to MQTT broker is re-established
 #define PLUGIN_MQTT_IMPORT                 37 // For P037 MQTT import
 #define PLUGIN_FORMAT_USERVAR              38 // Allow plugin specific formatting of a task variable (event->idx = variable)
+#define PLUGIN_GET_COMMANDS                39 // Return the comma separated list of (lower case) commands handled in PLUGIN_WRITE.
+                                              // Tasks of plugins not handling this call will be offered all commands.
 
 
 
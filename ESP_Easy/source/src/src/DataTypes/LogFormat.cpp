@@ -0,0 +1,24 @@
+#include "LogFormat.h"
+
+const __FlashStringHelper * getLogFormatString(LogFormat format) {
+  switch (format) {
+    case LogFormat::Text:                      return F("{}");
+    case LogFormat::Controller_InvalidValue:   return F("Invalid value detected for controller {}");
+    case LogFormat::MQTT_Connected:            return F("MQTT : Connected to broker with client ID: {}");
+    case LogFormat::MQTT_Subscribed:           return F("Subscribed to: {}");
+    case LogFormat::Formula_CompileError:      return F("Formula: {}#{} {}");
+    case LogFormat::Timer_InvalidNumber:       return F("TIMER: invalid timer number {}");
+    case LogFormat::Rules_Event:               return F("EVENT: {}");
+    case LogFormat::Rules_EventFileNotFound:   return F("EVENT: {} is ingnored. File {} not found.");
+    case LogFormat::Rules_EventProcessingTime: return F("EVENT: {} Processing time:{} milliSeconds");
+    case LogFormat::Rules_Action:              return F("ACT  : {}");
+    case LogFormat::Rules_If:                  return F("Lev.{}: [if {}]={}");
+    case LogFormat::Rules_ElseIf:              return F("Lev.{}: [elseif {}]={}");
+    case LogFormat::Rules_Else:                return F("Lev.{}: [else]={}");
+    case LogFormat::Rules_IfNestingExceeded:   return F("Lev.{}: Error: IF Nesting level exceeded!");
+    case LogFormat::Rules_Debug:               return F("RuleDebug: {}{}{}: {}");
+
+      // Do not use default: as this allows the compiler to detect any missing cases.
+  }
+  return F("{}");
+}
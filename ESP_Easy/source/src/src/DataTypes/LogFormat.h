@@ -0,0 +1,39 @@
+#ifndef DATATYPES_LOGFORMAT_H
+#define DATATYPES_LOGFORMAT_H
+
+#include <Arduino.h>
+
+/*********************************************************************************************\
+* LogFormat
+* Id of the format string of a structured log entry.
+* Each "{}" in the format string is replaced by the next argument when the entry is formatted.
+* Only the id is stored with the log entry, so do not re-use ids within a build.
+\*********************************************************************************************/
+enum class LogFormat : uint8_t {
+  Text = 0, // Plain text line, added via addLog(L, S)
+
+  // Controller
+  Controller_InvalidValue,
+  MQTT_Connected,
+  MQTT_Subscribed,
+  Formula_CompileError,
+
+  // Scheduler
+  Timer_InvalidNumber,
+
+  // Rules
+  Rules_Event,
+  Rules_EventFileNotFound,
+  Rules_EventProcessingTime,
+  Rules_Action,
+  Rules_If,
+  Rules_ElseIf,
+  Rules_Else,
+  Rules_IfNestingExceeded,
+  Rules_Debug
+};
+
+const __FlashStringHelper * getLogFormatString(LogFormat format);
+
+
+#endif // DATATYPES_LOGFORMAT_H
@@ -9,12 +9,14 @@
 
 #include "../DataStructs/ControllerSettingsStruct.h"
 #include "../DataStructs/ESPEasy_EventStruct.h"
+#include "../DataStructs/MQTT_inbound_message.h"
 
 #include "../DataTypes/ESPEasy_plugin_functions.h"
 
 #include "../ESPEasyCore/ESPEasyRules.h"
 #include "../ESPEasyCore/Serial.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/CPlugins.h"
 #include "../Globals/Device.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
@@ -23,6 +25,7 @@
 #include "../Globals/Plugins.h"
 #include "../Globals/Protocol.h"
 
+#include "../Helpers/_CPlugin_DomoticzHelper.h"
 #include "../Helpers/_CPlugin_Helper.h"
 #include "../Helpers/Misc.h"
 #include "../Helpers/Network.h"
@@ -30,6 +33,10 @@
 #include "../Helpers/PortStatus.h"
 #include "../Helpers/Rules_calculate.h"
 
+#include "../WebServer/Events.h"
+
+#include <utility> // std::move
+
 
 #define PLUGIN_ID_MQTT_IMPORT         37
 
@@ -44,6 +51,12 @@ void sendData(struct EventStruct *event)
   #endif // ifndef BUILD_NO_RAM_TRACKER
   LoadTaskSettings(event->TaskIndex);
 
+  // Plugin specific formatting may have changed, so format the values again when served via /json
+  Cache.markJsonTaskValuesChanged(event->TaskIndex);
+  #ifdef WEBSERVER_EVENTS
+  events_task_values_changed(event->TaskIndex);
+  #endif // ifdef WEBSERVER_EVENTS
+
   if (Settings.UseRules) {
     createRuleEvents(event);
   }
@@ -71,11 +84,7 @@ void sendData(struct EventStruct *event)
       }
 #ifndef BUILD_NO_DEBUG
       else {
-        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-          String log = F("Invalid value detected for controller ");
-          log += getCPluginNameFromProtocolIndex(ProtocolIndex);
-          addLog(LOG_LEVEL_DEBUG, log);
-        }
+        addLogFormat(LOG_LEVEL_DEBUG, LogFormat::Controller_InvalidValue, getCPluginNameFromProtocolIndex(ProtocolIndex));
       }
 #endif // ifndef BUILD_NO_DEBUG
     }
@@ -131,15 +140,46 @@ void incoming_mqtt_callback(char *c_topic, byte *b_payload, unsigned int length)
 
   // TD-er: This one cannot set the TaskIndex, but that may seem to work out.... hopefully.
   protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(enabledMqttController);
+  bool mustScheduleRecv          = true;
 
-  Scheduler.schedule_mqtt_controller_event_timer(
-    ProtocolIndex,
-    CPlugin::Function::CPLUGIN_PROTOCOL_RECV,
-    c_topic, b_payload, length);
+  #ifdef USES_C002
+
+  if (Protocol[ProtocolIndex].Number == 2 /* CPLUGIN_ID_002 */) {
+    // Drop messages for Domoticz devices not handled by any task, before copying topic and payload.
+    mustScheduleRecv = acceptDomoticzMessage(enabledMqttController, b_payload, length);
+  }
+  #endif // ifdef USES_C002
 
   deviceIndex_t DeviceIndex = getDeviceIndex(PLUGIN_ID_MQTT_IMPORT); // Check if P037_MQTTimport is present in the build
+  bool mustScheduleImport   = false;
 
   if (validDeviceIndex(DeviceIndex)) {
+    for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX && !mustScheduleImport; taskIndex++)
+    {
+      mustScheduleImport = Settings.TaskDeviceEnabled[taskIndex] && (Settings.TaskDeviceNumber[taskIndex] == PLUGIN_ID_MQTT_IMPORT);
+    }
+  }
+
+  if (!mustScheduleRecv && !mustScheduleImport) {
+    return;
+  }
+
+  // Copy topic and payload only once, all scheduled events share the same message.
+  MQTT_inbound_message_ptr_type message(new (std::nothrow) MQTT_inbound_message(c_topic, b_payload, length));
+
+  if (!message || !message->isValid()) {
+    addLog(LOG_LEVEL_ERROR, F("MQTT : Out of Memory! Cannot process MQTT message"));
+    return;
+  }
+
+  if (mustScheduleRecv) {
+    Scheduler.schedule_mqtt_controller_event_timer(
+      ProtocolIndex,
+      CPlugin::Function::CPLUGIN_PROTOCOL_RECV,
+      message);
+  }
+
+  if (mustScheduleImport) {
     //  Here we loop over all tasks and call each 037 plugin with function PLUGIN_MQTT_IMPORT
     for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
     {
@@ -147,7 +187,7 @@ void incoming_mqtt_callback(char *c_topic, byte *b_payload, unsigned int length)
       {
         Scheduler.schedule_mqtt_plugin_import_event_timer(
           DeviceIndex, taskIndex, PLUGIN_MQTT_IMPORT,
-          c_topic, b_payload, length);
+          message);
       }
     }
   }
@@ -245,17 +285,12 @@ bool MQTTConnect(controllerIndex_t controller_idx)
     updateMQTTclient_connected();
     return false;
   }
-  String log = F("MQTT : Connected to broker with client ID: ");
-
-  log += clientid;
-  addLog(LOG_LEVEL_INFO, log);
+  addLogFormat(LOG_LEVEL_INFO, LogFormat::MQTT_Connected, clientid);
   String subscribeTo = ControllerSettings.Subscribe;
 
   parseSystemVariables(subscribeTo, false);
   MQTTclient.subscribe(subscribeTo.c_str());
-  log  = F("Subscribed to: ");
-  log += subscribeTo;
-  addLog(LOG_LEVEL_INFO, log);
+  addLogFormat(LOG_LEVEL_INFO, LogFormat::MQTT_Subscribed, subscribeTo);
 
   updateMQTTclient_connected();
   statusLED(true);
@@ -506,6 +541,21 @@ bool MQTTpublish(controllerIndex_t controller_idx, const char *topic, const char
   return success;
 }
 
+bool MQTTpublish(controllerIndex_t controller_idx, String&& topic, String&& payload, bool retained)
+{
+  if (MQTTDelayHandler == nullptr) {
+    return false;
+  }
+
+  if (MQTT_queueFull(controller_idx)) {
+    return false;
+  }
+  const bool success = MQTTDelayHandler->addToQueue(MQTT_queue_element(controller_idx, std::move(topic), std::move(payload), retained));
+
+  scheduleNextMQTTdelayQueue();
+  return success;
+}
+
 /*********************************************************************************************\
 * Send status info back to channel where request came from
 \*********************************************************************************************/
@@ -568,6 +618,44 @@ void MQTTStatus(struct EventStruct *event, const String& status)
 // }
 
 
+/*********************************************************************************************\
+* Get the compiled formulas of a task, compile them when not present in the cache.
+* ExtraTaskSettings must be loaded for the given task.
+\*********************************************************************************************/
+const CompiledTaskFormulas& getCompiledTaskFormulas(taskIndex_t TaskIndex)
+{
+  auto it = Cache.taskFormula.find(TaskIndex);
+
+  if (it != Cache.taskFormula.end()) {
+    return it->second;
+  }
+
+  START_TIMER;
+  CompiledTaskFormulas& formulas = Cache.taskFormula[TaskIndex];
+
+  for (byte varNr = 0; varNr < VARS_PER_TASK; varNr++)
+  {
+    formulas.compileResult[varNr] = CalculateReturnCode::OK;
+
+    if (ExtraTaskSettings.TaskDeviceFormula[varNr][0] != 0)
+    {
+      formulas.compileResult[varNr] = RulesCalculate.compile(
+        ExtraTaskSettings.TaskDeviceFormula[varNr],
+        formulas.program[varNr],
+        true);
+
+      if (isError(formulas.compileResult[varNr])) {
+        addLogFormat(LOG_LEVEL_ERROR, LogFormat::Formula_CompileError,
+                     getTaskDeviceName(TaskIndex),
+                     ExtraTaskSettings.TaskDeviceValueNames[varNr],
+                     toString(formulas.compileResult[varNr]));
+      }
+    }
+  }
+  STOP_TIMER(COMPILE_FORMULA_STATS);
+  return formulas;
+}
+
 /*********************************************************************************************\
 * send specific sensor task data, effectively calling PluginCall(PLUGIN_READ...)
 \*********************************************************************************************/
@@ -610,18 +698,19 @@ void SensorSendTask(taskIndex_t TaskIndex)
     if (success)
     {
       if (Device[DeviceIndex].FormulaOption) {
+        const CompiledTaskFormulas& formulas = getCompiledTaskFormulas(TaskIndex);
         START_TIMER;
 
         for (byte varNr = 0; varNr < VARS_PER_TASK; varNr++)
         {
-          if (ExtraTaskSettings.TaskDeviceFormula[varNr][0] != 0)
+          if ((ExtraTaskSettings.TaskDeviceFormula[varNr][0] != 0) && !isError(formulas.compileResult[varNr]))
           {
-            String formula = ExtraTaskSettings.TaskDeviceFormula[varNr];
-            formula.replace(F("%pvalue%"), String(preValue[varNr]));
-            formula.replace(F("%value%"),  String(UserVar[TempEvent.BaseVarIndex + varNr]));
+            double variables[static_cast<int>(CalculateVariable::NrVariables)];
+            variables[static_cast<int>(CalculateVariable::Value)]         = UserVar[TempEvent.BaseVarIndex + varNr];
+            variables[static_cast<int>(CalculateVariable::PreviousValue)] = preValue[varNr];
             double result = 0;
 
-            if (!isError(Calculate(formula, result))) {
+            if (!isError(RulesCalculate.evaluate(formulas.program[varNr], variables, &result))) {
               UserVar[TempEvent.BaseVarIndex + varNr] = result;
             }
           }
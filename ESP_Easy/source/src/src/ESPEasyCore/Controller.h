@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataTypes/EventValueSource.h"
+#include "../DataStructs/Caches.h"
 #include "../Globals/CPlugins.h"
 
 // ********************************************************************************
@@ -61,6 +62,9 @@ bool MQTT_queueFull(controllerIndex_t controller_idx);
 
 bool MQTTpublish(controllerIndex_t controller_idx, const char *topic, const char *payload, bool retained);
 
+// Move topic and payload into the queue, without making a copy.
+bool MQTTpublish(controllerIndex_t controller_idx, String&& topic, String&& payload, bool retained);
+
 
 /*********************************************************************************************\
 * Send status info back to channel where request came from
@@ -76,6 +80,11 @@ void MQTTStatus(struct EventStruct *event, const String& status);
 // void SensorSendAll();
 
 
+/*********************************************************************************************\
+ * Get the compiled formulas of a task, compile them when not present in the cache.
+\*********************************************************************************************/
+const CompiledTaskFormulas& getCompiledTaskFormulas(taskIndex_t TaskIndex);
+
 /*********************************************************************************************\
  * send specific sensor task data, effectively calling PluginCall(PLUGIN_READ...)
 \*********************************************************************************************/
@@ -9,6 +9,7 @@
 #include "../Globals/ExtraTaskSettings.h"
 #include "../Globals/Plugins.h"
 #include "../Globals/Plugins_other.h"
+#include "../Globals/RulesSetCache.h"
 #include "../Globals/Settings.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/ESPEasy_time_calc.h"
@@ -56,16 +57,21 @@ String FileNameToEvent(const String& fileName) {
   return eventName;
 }
 
-void checkRuleSets() {
-  for (byte x = 0; x < RULESETS_MAX; x++) {
+String getRulesSetFileName(byte rulesSet) {
 #if defined(ESP8266)
-    String fileName = F("rules");
+  String fileName = F("rules");
 #endif // if defined(ESP8266)
 #if defined(ESP32)
-    String fileName = F("/rules");
+  String fileName = F("/rules");
 #endif // if defined(ESP32)
-    fileName += x + 1;
-    fileName += F(".txt");
+  fileName += rulesSet + 1;
+  fileName += F(".txt");
+  return fileName;
+}
+
+void checkRuleSets() {
+  for (byte x = 0; x < RULESETS_MAX; x++) {
+    const String fileName = getRulesSetFileName(x);
 
     if (fileExists(fileName)) {
       activeRuleSets[x] = true;
@@ -83,6 +89,9 @@ void checkRuleSets() {
     }
 #endif // ifndef BUILD_NO_DEBUG
   }
+
+  // Rules may have changed, parse them again when needed.
+  rulesSetCache.clear();
 }
 
 /********************************************************************************************\
@@ -91,7 +100,8 @@ void checkRuleSets() {
 bool processNextEvent() {
   if (Settings.UseRules)
   {
-    String nextEvent;
+    // Keep the String object, so its buffer is swapped back into the event queue for reuse.
+    static String nextEvent;
 
     if (eventQueue.getNext(nextEvent)) {
       rulesProcessing(nextEvent);
@@ -119,25 +129,14 @@ void rulesProcessing(String& event) {
   unsigned long timer = millis();
 #endif // ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-    String log = F("EVENT: ");
-    log += event;
-    addLog(LOG_LEVEL_INFO, log);
-  }
+  addLogFormat(LOG_LEVEL_INFO, LogFormat::Rules_Event, event);
 
   if (Settings.OldRulesEngine()) {
     for (byte x = 0; x < RULESETS_MAX; x++) {
-#if defined(ESP8266)
-      String fileName = F("rules");
-#endif // if defined(ESP8266)
-#if defined(ESP32)
-      String fileName = F("/rules");
-#endif // if defined(ESP32)
-      fileName += x + 1;
-      fileName += F(".txt");
-
       if (activeRuleSets[x]) {
-        rulesProcessingFile(fileName, event);
+        if (!rulesProcessingParsedSet(x, event)) {
+          rulesProcessingFile(getRulesSetFileName(x), event);
+        }
       }
     }
   } else {
@@ -150,9 +149,7 @@ void rulesProcessing(String& event) {
     }
 # ifndef BUILD_NO_DEBUG
     else {
-      addLog(LOG_LEVEL_DEBUG, String(F("EVENT: ")) + event +
-             String(F(" is ingnored. File ")) + fileName +
-             String(F(" not found.")));
+      addLogFormat(LOG_LEVEL_DEBUG, LogFormat::Rules_EventFileNotFound, event, fileName);
     }
 # endif    // ifndef BUILD_NO_DEBUG
     #endif // WEBSERVER_NEW_RULES
@@ -160,14 +157,7 @@ void rulesProcessing(String& event) {
 
 #ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    String log = F("EVENT: ");
-    log += event;
-    log += F(" Processing time:");
-    log += timePassedSince(timer);
-    log += F(" milliSeconds");
-    addLog(LOG_LEVEL_DEBUG, log);
-  }
+  addLogFormat(LOG_LEVEL_DEBUG, LogFormat::Rules_EventProcessingTime, event, timePassedSince(timer));
 #endif // ifndef BUILD_NO_DEBUG
   STOP_TIMER(RULES_PROCESSING);
   backgroundtasks();
@@ -176,6 +166,8 @@ void rulesProcessing(String& event) {
 /********************************************************************************************\
    Rules processing
  \*********************************************************************************************/
+static byte rulesNestingLevel = 0;
+
 String rulesProcessingFile(const String& fileName, String& event) {
   if (!Settings.UseRules || !fileExists(fileName)) {
     return F("");
@@ -192,24 +184,16 @@ String rulesProcessingFile(const String& fileName, String& event) {
   }
 #endif // ifndef BUILD_NO_DEBUG
 
-  static byte nestingLevel = 0;
   String log;
 
-  nestingLevel++;
+  rulesNestingLevel++;
 
-  if (nestingLevel > RULES_MAX_NESTING_LEVEL) {
+  if (rulesNestingLevel > RULES_MAX_NESTING_LEVEL) {
     addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
-    nestingLevel--;
+    rulesNestingLevel--;
     return log;
   }
 
-  fs::File f = tryOpenFile(fileName, "r+");
-  SPIFFS_CHECK(f, fileName.c_str());
-
-  // Try to get the best possible estimate on line length based on earlier parsing of the rules.
-  static size_t longestLineSize = RULES_BUFFER_SIZE;
-  String line;
-  line.reserve(longestLineSize);
   bool match     = false;
   bool codeBlock = false;
   bool isCommand = false;
@@ -218,6 +202,117 @@ String rulesProcessingFile(const String& fileName, String& event) {
   byte ifBlock     = 0;
   byte fakeIfBlock = 0;
 
+  rulesReadFileLines(fileName, [&](String& line)
+  {
+    // Parse the line and extract the action (if there is any)
+    String action;
+    parseCompleteNonCommentLine(line, event, log, action, match, codeBlock,
+                                isCommand, condition, ifBranche, ifBlock,
+                                fakeIfBlock);
+
+    if (match) // rule matched for one action or a block of actions
+    {
+      processMatchedRule(action, event, log, match, codeBlock,
+                         isCommand, condition, ifBranche, ifBlock, fakeIfBlock);
+    }
+
+    backgroundtasks();
+  });
+
+  rulesNestingLevel--;
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("rulesProcessingFile2"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+  return F("");
+}
+
+/********************************************************************************************\
+   Rules processing using the parsed rules set kept in RAM
+   Return false when the rules set is not available in the cache.
+ \*********************************************************************************************/
+bool rulesProcessingParsedSet(byte rulesSet, String& event) {
+  const RulesSetCache::ParsedRulesSet *parsed = rulesSetCache.get(rulesSet);
+
+  if (parsed == nullptr) {
+    return false;
+  }
+#ifndef BUILD_NO_DEBUG
+
+  if (Settings.SerialLogLevel == LOG_LEVEL_DEBUG_DEV) {
+    serialPrint(F("RuleDebug Processing cached set:"));
+    serialPrintln(String(rulesSet + 1));
+    serialPrintln(F("     flags CMI  parse output:"));
+  }
+#endif // ifndef BUILD_NO_DEBUG
+
+  rulesNestingLevel++;
+
+  if (rulesNestingLevel > RULES_MAX_NESTING_LEVEL) {
+    addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
+    rulesNestingLevel--;
+    return true;
+  }
+
+  // Make sure the parsed lines are kept while processing,
+  // as the rules may be changed (e.g. via the web interface) during backgroundtasks()
+  rulesSetCache.claim();
+
+  // Only process the blocks which may match the event, in order of appearance.
+  std::vector<uint16_t> candidates;
+  parsed->getCandidateBlocks(event, candidates);
+
+  for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+    rulesProcessingBlock(*parsed, parsed->blocks[*it], event);
+  }
+
+  rulesSetCache.release();
+  rulesNestingLevel--;
+  return true;
+}
+
+void rulesProcessingBlock(const RulesSetCache::ParsedRulesSet& parsed,
+                          const RulesSetCache::Block         & block,
+                          String                             & event) {
+  String log;
+  bool   match     = false;
+  bool   codeBlock = false;
+  bool   isCommand = false;
+  bool   condition[RULES_IF_MAX_NESTING_LEVEL];
+  bool   ifBranche[RULES_IF_MAX_NESTING_LEVEL];
+  byte   ifBlock     = 0;
+  byte   fakeIfBlock = 0;
+
+  for (uint16_t i = 0; i < block.nrLines; ++i) {
+    String line = parsed.getLine(block.firstLine + i);
+    String action;
+    parseCompleteNonCommentLine(line, event, log, action, match, codeBlock,
+                                isCommand, condition, ifBranche, ifBlock,
+                                fakeIfBlock);
+
+    if (!match) {
+      // Either the "on ... do" line did not match the event,
+      // or "endon" was reached. The rest of the block will not be processed.
+      return;
+    }
+    processMatchedRule(action, event, log, match, codeBlock,
+                       isCommand, condition, ifBranche, ifBlock, fakeIfBlock);
+    backgroundtasks();
+  }
+}
+
+/********************************************************************************************\
+   Read rules file and call the handler for each non empty line.
+   Leading white space and comment lines are stripped.
+ \*********************************************************************************************/
+String rulesReadFileLines(const String& fileName, RulesLineHandler handler) {
+  fs::File f = tryOpenFile(fileName, "r+");
+  SPIFFS_CHECK(f, fileName.c_str());
+
+  // Try to get the best possible estimate on line length based on earlier parsing of the rules.
+  static size_t longestLineSize = RULES_BUFFER_SIZE;
+  String line;
+  line.reserve(longestLineSize);
+
   std::vector<byte> buf;
   buf.resize(RULES_BUFFER_SIZE);
 
@@ -244,19 +339,7 @@ String rulesProcessingFile(const String& fileName, String& event) {
           }
 
           if ((lineLength > 0) && !line.startsWith(F("//"))) {
-            // Parse the line and extract the action (if there is any)
-            String action;
-            parseCompleteNonCommentLine(line, event, log, action, match, codeBlock,
-                                        isCommand, condition, ifBranche, ifBlock,
-                                        fakeIfBlock);
-
-            if (match) // rule matched for one action or a block of actions
-            {
-              processMatchedRule(action, event, log, match, codeBlock,
-                                 isCommand, condition, ifBranche, ifBlock, fakeIfBlock);
-            }
-
-            backgroundtasks();
+            handler(line);
           }
 
           // Prepare for new line
@@ -305,11 +388,6 @@ String rulesProcessingFile(const String& fileName, String& event) {
   if (f) {
     f.close();
   }
-
-  nestingLevel--;
-  #ifndef BUILD_NO_RAM_TRACKER
-  checkRAM(F("rulesProcessingFile2"));
-  #endif // ifndef BUILD_NO_RAM_TRACKER
   return F("");
 }
 
@@ -793,15 +871,11 @@ void parseCompleteNonCommentLine(String& line, String& event, String& log,
 
 #ifndef BUILD_NO_DEBUG
 
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG_DEV)) {
-    String log = F("RuleDebug: ");
-    log += codeBlock ? 0 : 1;
-    log += match ? 0 : 1;
-    log += isCommand ? 0 : 1;
-    log += ": ";
-    log += line;
-    addLog(LOG_LEVEL_DEBUG_DEV, log);
-  }
+  addLogFormat(LOG_LEVEL_DEBUG_DEV, LogFormat::Rules_Debug,
+               codeBlock ? 0 : 1,
+               match ? 0 : 1,
+               isCommand ? 0 : 1,
+               line);
 #endif // ifndef BUILD_NO_DEBUG
 }
 
@@ -839,15 +913,7 @@ void processMatchedRule(String& action, String& event,
           condition[ifBlock - 1] = conditionMatchExtended(check);
 #ifndef BUILD_NO_DEBUG
 
-          if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-            log  = F("Lev.");
-            log += String(ifBlock);
-            log += F(": [elseif ");
-            log += check;
-            log += F("]=");
-            log += boolToString(condition[ifBlock - 1]);
-            addLog(LOG_LEVEL_DEBUG, log);
-          }
+          addLogFormat(LOG_LEVEL_DEBUG, LogFormat::Rules_ElseIf, ifBlock, check, boolToString(condition[ifBlock - 1]));
 #endif // ifndef BUILD_NO_DEBUG
         }
       }
@@ -866,15 +932,7 @@ void processMatchedRule(String& action, String& event,
           ifBranche[ifBlock - 1] = true;
 #ifndef BUILD_NO_DEBUG
 
-          if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-            log  = F("Lev.");
-            log += String(ifBlock);
-            log += F(": [if ");
-            log += check;
-            log += F("]=");
-            log += boolToString(condition[ifBlock - 1]);
-            addLog(LOG_LEVEL_DEBUG, log);
-          }
+          addLogFormat(LOG_LEVEL_DEBUG, LogFormat::Rules_If, ifBlock, check, boolToString(condition[ifBlock - 1]));
 #endif // ifndef BUILD_NO_DEBUG
         } else {
           fakeIfBlock++;
@@ -882,12 +940,7 @@ void processMatchedRule(String& action, String& event,
       } else {
         fakeIfBlock++;
 
-        if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-          log  = F("Lev.");
-          log += String(ifBlock);
-          log += F(": Error: IF Nesting level exceeded!");
-          addLog(LOG_LEVEL_ERROR, log);
-        }
+        addLogFormat(LOG_LEVEL_ERROR, LogFormat::Rules_IfNestingExceeded, ifBlock);
       }
       isCommand = false;
     }
@@ -901,13 +954,7 @@ void processMatchedRule(String& action, String& event,
     isCommand              = false;
 #ifndef BUILD_NO_DEBUG
 
-    if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-      log  = F("Lev.");
-      log += String(ifBlock);
-      log += F(": [else]=");
-      log += boolToString(condition[ifBlock - 1] == ifBranche[ifBlock - 1]);
-      addLog(LOG_LEVEL_DEBUG, log);
-    }
+    addLogFormat(LOG_LEVEL_DEBUG, LogFormat::Rules_Else, ifBlock, boolToString(condition[ifBlock - 1] == ifBranche[ifBlock - 1]));
 #endif // ifndef BUILD_NO_DEBUG
   }
 
@@ -927,11 +974,7 @@ void processMatchedRule(String& action, String& event,
   if (isCommand) {
     substitute_eventvalue(action, event);
 
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      String actionlog = F("ACT  : ");
-      actionlog += action;
-      addLog(LOG_LEVEL_INFO, actionlog);
-    }
+    addLogFormat(LOG_LEVEL_INFO, LogFormat::Rules_Action, action);
 
     ExecuteCommand_all(EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str());
     delay(0);
@@ -1392,6 +1435,7 @@ void createRuleEvents(struct EventStruct *event) {
   LoadTaskSettings(event->TaskIndex);
 
   const byte valueCount = getValueCountForTask(event->TaskIndex);
+  const bool coalesce   = Settings.CoalesceTaskValueEvents(event->TaskIndex);
 
   if (Settings.CombineTaskValues_SingleEvent(event->TaskIndex)) {
     String eventString;
@@ -1405,7 +1449,7 @@ void createRuleEvents(struct EventStruct *event) {
       }
       eventString += formatUserVarNoCheck(event, varNr);
     }
-    eventQueue.add(eventString);
+    eventQueue.addTaskValueEvent(eventString, coalesce);
   } else {
     for (byte varNr = 0; varNr < valueCount; varNr++) {
       String eventString;
@@ -1415,7 +1459,8 @@ void createRuleEvents(struct EventStruct *event) {
       eventString += ExtraTaskSettings.TaskDeviceValueNames[varNr];
       eventString += F("=");
       eventString += formatUserVarNoCheck(event, varNr);
-      eventQueue.add(eventString);
+
+      eventQueue.addTaskValueEvent(eventString, coalesce);
     }
   }
 }
@@ -7,11 +7,18 @@
 #include "../../ESPEasy_common.h"
 
 #include "../CustomBuild/ESPEasyLimits.h"
+#include "../DataStructs/RulesSetCache.h"
+
+#include <functional>
 
 
 extern boolean activeRuleSets[RULESETS_MAX];
 
 
+typedef std::function<void (String&)> RulesLineHandler;
+
+String getRulesSetFileName(byte rulesSet);
+
 String EventToFileName(const String& eventName);
 
 String FileNameToEvent(const String& fileName);
@@ -35,6 +42,24 @@ void   rulesProcessing(String& event);
 String rulesProcessingFile(const String& fileName,
                            String      & event);
 
+/********************************************************************************************\
+   Rules processing using the parsed rules set kept in RAM
+   Return false when the rules set is not available in the cache.
+ \*********************************************************************************************/
+bool rulesProcessingParsedSet(byte    rulesSet,
+                              String& event);
+
+void rulesProcessingBlock(const RulesSetCache::ParsedRulesSet& parsed,
+                          const RulesSetCache::Block         & block,
+                          String                             & event);
+
+/********************************************************************************************\
+   Read rules file and call the handler for each non empty line.
+   Leading white space and comment lines are stripped.
+ \*********************************************************************************************/
+String rulesReadFileLines(const String   & fileName,
+                          RulesLineHandler handler);
+
 
 /********************************************************************************************\
    Strip comment from the line.
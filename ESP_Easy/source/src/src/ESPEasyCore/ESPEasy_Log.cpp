@@ -1,6 +1,7 @@
 #include "ESPEasy_Log.h"
 
 #include "../DataStructs/LogStruct.h"
+#include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/Serial.h"
 #include "../Globals/Cache.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
@@ -176,7 +177,19 @@ void addToLog(byte loglevel, const String& string)
   addToLog(loglevel, string.c_str());
 }
 
-void addToLog(byte logLevel, const char *line)
+// Check whether a destination needing the formatted line right away is active.
+static bool textLogActiveFor(byte logLevel)
+{
+  return loglevelActiveFor(LOG_TO_SERIAL, logLevel) ||
+         loglevelActiveFor(LOG_TO_SYSLOG, logLevel)
+#ifdef FEATURE_SD
+         || loglevelActiveFor(LOG_TO_SDCARD, logLevel)
+#endif
+  ;
+}
+
+// Send the line to the destinations needing the formatted line right away.
+static void addToTextLog(byte logLevel, const char *line)
 {
   // Please note all functions called from here handling line must be PROGMEM aware.
   if (loglevelActiveFor(LOG_TO_SERIAL, logLevel)) {
@@ -194,9 +207,6 @@ void addToLog(byte logLevel, const char *line)
   if (loglevelActiveFor(LOG_TO_SYSLOG, logLevel)) {
     syslog(logLevel, line);
   }
-  if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
-    Logging.add(logLevel, line);
-  }
 
 #ifdef FEATURE_SD
   if (loglevelActiveFor(LOG_TO_SDCARD, logLevel)) {
@@ -219,3 +229,33 @@ void addToLog(byte logLevel, const char *line)
   }
 #endif
 }
+
+void addToLog(byte logLevel, const char *line)
+{
+  START_TIMER
+  addToTextLog(logLevel, line);
+  if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
+    Logging.add(logLevel, line);
+  }
+  STOP_TIMER(ADD_LOG_TEXT);
+}
+
+void addToLog(byte logLevel, LogFormat format,
+              const LogArg& arg1, const LogArg& arg2,
+              const LogArg& arg3, const LogArg& arg4)
+{
+  START_TIMER
+  const LogArg args[LOG_ENTRY_MAX_ARGS] = { arg1, arg2, arg3, arg4 };
+  size_t nrArgs = 0;
+  while (nrArgs < LOG_ENTRY_MAX_ARGS && args[nrArgs].type != LogArg::Type::None) {
+    ++nrArgs;
+  }
+  if (textLogActiveFor(logLevel)) {
+    const String line = formatLogMessage(format, args, nrArgs);
+    addToTextLog(logLevel, line.c_str());
+  }
+  if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
+    Logging.add(logLevel, format, args, nrArgs);
+  }
+  STOP_TIMER(ADD_LOG_FORMAT);
+}
@@ -4,6 +4,8 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/LogArg.h"
+
 #define LOG_LEVEL_NONE                      0
 #define LOG_LEVEL_ERROR                     1
 #define LOG_LEVEL_INFO                      2
@@ -50,8 +52,21 @@ void addToLog(byte loglevel, const String& string);
 
 void addToLog(byte logLevel, const char *line);
 
+// Structured log entry, see LogFormat.
+// The message is only formatted for the destinations needing text right away (serial, syslog, SD).
+// The web log keeps the arguments and formats the message when it is read.
+void addToLog(byte          logLevel,
+              LogFormat     format,
+              const LogArg& arg1 = LogArg(),
+              const LogArg& arg2 = LogArg(),
+              const LogArg& arg3 = LogArg(),
+              const LogArg& arg4 = LogArg());
+
 // Do this in a template to prevent casting to String when not needed.
 #define addLog(L,S) if (loglevelActiveFor(L)) { addToLog(L,S); }
 
+// Only evaluate the arguments when the log level is active.
+#define addLogFormat(L, ...) if (loglevelActiveFor(L)) { addToLog(L, __VA_ARGS__); }
+
 
 #endif 
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "../Globals/Logging.h"
 
 #include "../DataStructs/LogStruct.h"
+#include "../DataStructs/SyslogQueue.h"
 
 
 LogStruct Logging;
@@ -8,4 +9,6 @@ LogStruct Logging;
 uint8_t highest_active_log_level = 0;
 bool log_to_serial_disabled = false;
 
-std::deque<char> serialWriteBuffer;
\ No newline at end of file
+std::deque<char> serialWriteBuffer;
+
+SyslogQueue syslogQueue;
\ No newline at end of file
@@ -16,4 +16,10 @@ extern LogStruct Logging;
 \*********************************************************************************************/
 extern std::deque<char> serialWriteBuffer;
 
+/*********************************************************************************************\
+ * Buffer for log lines to be sent to syslog.
+\*********************************************************************************************/
+struct SyslogQueue;
+extern SyslogQueue syslogQueue;
+
 #endif // GLOBALS_LOGGING_H
\ No newline at end of file
@@ -253,6 +253,66 @@ void queueTaskEvent(const String& eventName, taskIndex_t taskIndex, int value1)
 }
 
 
+/**
+ * Check whether the plugin may handle the (lower case) command in PLUGIN_WRITE.
+ * Plugins not declaring their commands via PLUGIN_GET_COMMANDS may handle any command.
+ */
+bool pluginMayHandleCommand(deviceIndex_t DeviceIndex, const String& command) {
+  struct EventStruct TempEvent;
+  String commands;
+
+  if (!Plugin_ptr[DeviceIndex](PLUGIN_GET_COMMANDS, &TempEvent, commands)) {
+    return true;
+  }
+  String list;
+
+  list.reserve(commands.length() + 2);
+  list += ',';
+  list += commands;
+  list += ',';
+
+  String needle;
+
+  needle.reserve(command.length() + 2);
+  needle += ',';
+  needle += command;
+  needle += ',';
+  return list.indexOf(needle) != -1;
+}
+
+/**
+ * Collect the enabled tasks which may handle the (lower case) command in PLUGIN_WRITE, in order of task index.
+ */
+void getPluginCommandTasks(const String& command, std::vector<taskIndex_t>& tasks) {
+  if (Cache.getCachedPluginCommandTasks(command, tasks)) {
+    return;
+  }
+  tasks.clear();
+
+  // Each plugin only needs to be asked once, even when used in multiple tasks.
+  std::map<deviceIndex_t, bool> mayHandle;
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
+  {
+    if (Settings.TaskDeviceEnabled[taskIndex]) {
+      const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(taskIndex);
+
+      if (validDeviceIndex(DeviceIndex)) {
+        auto it = mayHandle.find(DeviceIndex);
+
+        if (it == mayHandle.end()) {
+          it = mayHandle.emplace(DeviceIndex, pluginMayHandleCommand(DeviceIndex, command)).first;
+        }
+
+        if (it->second) {
+          tasks.push_back(taskIndex);
+        }
+      }
+    }
+  }
+  Cache.cachePluginCommandTasks(command, tasks);
+}
+
 /**
  * Call the plugin of 1 task for 1 function, with standard EventStruct and optional command string
  */
@@ -450,6 +510,22 @@ bool PluginCall(byte Function, struct EventStruct *event, String& str)
   // info += lastTask;
   // addLog(LOG_LEVEL_INFO, info);
 
+      if ((Function == PLUGIN_WRITE) && ((lastTask - firstTask) > 1)) {
+        // Not addressed to a single task, only offer the command to tasks which may handle it.
+        // Keep a copy of the list, as the cache may be cleared by the called task.
+        std::vector<taskIndex_t> tasks;
+        getPluginCommandTasks(parseString(command, 1), tasks);
+
+        for (auto it = tasks.begin(); it != tasks.end(); ++it)
+        {
+          if (PluginCallForTask(*it, Function, &TempEvent, command)) {
+            CPluginCall(CPlugin::Function::CPLUGIN_ACKNOWLEDGE, &TempEvent, command);
+            return true;
+          }
+        }
+        return false;
+      }
+
       for (taskIndex_t task = firstTask; task < lastTask; task++)
       {
         bool retval = PluginCallForTask(task, Function, &TempEvent, command);
@@ -493,10 +569,22 @@ bool PluginCall(byte Function, struct EventStruct *event, String& str)
       return false;
     }
 
-    // Call to all plugins that are used in a task
+    // Call to all tasks of plugins which handle the periodic call
     case PLUGIN_ONCE_A_SECOND:
     case PLUGIN_TEN_PER_SECOND:
     case PLUGIN_FIFTY_PER_SECOND:
+    {
+      const std::vector<taskIndex_t>& tasks = Cache.getPeriodicCallTasks(Function);
+
+      // Check the size on every iteration, the list may be updated by a called task.
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        PluginCallForTask(tasks[i], Function, &TempEvent, str, event);
+      }
+      return true;
+    }
+
+    // Call to all plugins that are used in a task
     case PLUGIN_INIT_ALL:
     case PLUGIN_CLOCK_IN:
     case PLUGIN_EVENT_OUT:
@@ -0,0 +1,4 @@
+#include "../Globals/RulesSetCache.h"
+
+
+RulesSetCache rulesSetCache;
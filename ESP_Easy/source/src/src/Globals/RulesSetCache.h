@@ -0,0 +1,8 @@
+#ifndef GLOBALS_RULESSETCACHE_H
+#define GLOBALS_RULESSETCACHE_H
+
+#include "../DataStructs/RulesSetCache.h"
+
+extern RulesSetCache rulesSetCache;
+
+#endif // GLOBALS_RULESSETCACHE_H
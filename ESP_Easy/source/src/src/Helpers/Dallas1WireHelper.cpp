@@ -7,6 +7,8 @@
 
 #include "../WebServer/JSON.h"
 
+#include <map>
+
 
 #if defined(ESP32)
   # define ESP32noInterrupts() { portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED; portENTER_CRITICAL(&mux)
@@ -23,6 +25,9 @@ long usec_release   = 0;
 long presence_start = 0;
 long presence_end   = 0;
 
+// Conversion state per bus, key is the RX GPIO pin.
+std::map<int8_t, Dallas_BusData> Dallas_buses;
+
 
 // References to 1-wire family codes:
 // http://owfs.sourceforge.net/simple_family.html
@@ -304,6 +309,125 @@ bool Dallas_is_parasite(const uint8_t ROM[8], int8_t gpio_pin_rx, int8_t gpio_pi
   return !Dallas_read_bit(gpio_pin_rx, gpio_pin_tx);
 }
 
+/*********************************************************************************************\
+*  Dallas bus conversion
+\*********************************************************************************************/
+void Dallas_updateBusSettings(Dallas_BusData& bus)
+{
+  bus.maxResolution   = 0;
+  bus.parasitePowered = false;
+
+  for (auto it = bus.users.begin(); it != bus.users.end(); ++it) {
+    if (it->second.res > bus.maxResolution) {
+      bus.maxResolution = it->second.res;
+    }
+
+    if (it->second.parasitePowered) {
+      bus.parasitePowered = true;
+    }
+  }
+}
+
+void Dallas_registerBusSensor(int8_t gpio_pin_rx, const void *owner, uint8_t res, bool parasitePowered)
+{
+  Dallas_BusData& bus  = Dallas_buses[gpio_pin_rx];
+  Dallas_BusUser& user = bus.users[owner];
+
+  if (res > user.res) {
+    user.res = res;
+  }
+
+  if (parasitePowered) {
+    user.parasitePowered = true;
+  }
+  Dallas_updateBusSettings(bus);
+}
+
+void Dallas_unregisterBusSensors(int8_t gpio_pin_rx, const void *owner)
+{
+  auto it = Dallas_buses.find(gpio_pin_rx);
+
+  if (it == Dallas_buses.end()) {
+    return;
+  }
+  it->second.users.erase(owner);
+  Dallas_updateBusSettings(it->second);
+}
+
+bool Dallas_busConversionActive(int8_t gpio_pin_rx)
+{
+  auto it = Dallas_buses.find(gpio_pin_rx);
+
+  if ((it == Dallas_buses.end()) || (it->second.conversions == 0)) {
+    return false;
+  }
+  return !timeOutReached(it->second.ready);
+}
+
+unsigned long Dallas_startBusConversion(int8_t gpio_pin_rx, int8_t gpio_pin_tx, bool& joined)
+{
+  Dallas_BusData& bus = Dallas_buses[gpio_pin_rx];
+
+  joined = (bus.conversions != 0) && !timeOutReached(bus.ready);
+
+  if (joined) {
+    ++bus.joined;
+    return bus.ready;
+  }
+
+  if (!Dallas_reset(gpio_pin_rx, gpio_pin_tx)) {
+    ++bus.failed;
+    return 0;
+  }
+  Dallas_write(0xCC, gpio_pin_rx, gpio_pin_tx); // Skip ROM, address all devices
+  Dallas_write(0x44, gpio_pin_rx, gpio_pin_tx); // Take temperature measurement
+
+  // Parasite powered sensors cannot be polled for conversion done and
+  // may not be set to a lower resolution, so always wait the max. conversion time.
+  const uint8_t res = bus.parasitePowered ? 12 : bus.maxResolution;
+
+  bus.start = millis();
+  bus.ready = bus.start + Dallas_conversionTime(res);
+
+  if (bus.ready == 0) { bus.ready = 1; }
+  ++bus.conversions;
+  return bus.ready;
+}
+
+/*********************************************************************************************\
+*  Dallas Start Temperature Conversion, expected max duration:
+*    9 bits resolution ->  93.75 ms
+*   10 bits resolution -> 187.5 ms
+*   11 bits resolution -> 375 ms
+*   12 bits resolution -> 750 ms
+\*********************************************************************************************/
+unsigned long Dallas_conversionTime(uint8_t res)
+{
+  if ((res < 9) || (res > 12)) { res = 12; }
+  return 800 / (1 << (12 - res));
+}
+
+void Dallas_show_bus_stats_webform_load(int8_t gpio_pin_rx)
+{
+  auto it = Dallas_buses.find(gpio_pin_rx);
+
+  if (it == Dallas_buses.end()) {
+    return;
+  }
+  addRowLabel(F("Bus Conversions"));
+  addHtmlInt(it->second.conversions);
+
+  addRowLabel(F("Bus Conversions Joined"));
+  addHtmlInt(it->second.joined);
+
+  addRowLabel(F("Bus Conversions Failed"));
+  addHtmlInt(it->second.failed);
+
+  addRowLabel(F("Bus Conversion Time"));
+  addHtmlInt(timeDiff(it->second.start, it->second.ready));
+  addHtml(F(" ms"));
+}
+
 void Dallas_startConversion(const uint8_t ROM[8], int8_t gpio_pin_rx, int8_t gpio_pin_tx)
 {
   Dallas_reset(gpio_pin_rx, gpio_pin_tx);
@@ -6,6 +6,8 @@
 #include "../DataTypes/TaskIndex.h"
 #include "../DataTypes/PluginID.h"
 
+#include <map>
+
 // Used timings based on Maxim documentation.
 // See https://www.maximintegrated.com/en/design/technical-documents/app-notes/1/126.html
 // We use the "standard speed" timings, not the "Overdrive speed"
@@ -40,6 +42,57 @@ struct Dallas_SensorData {
 
 
 
+/*********************************************************************************************\
+   Temperature conversion of all sensors sharing a GPIO pin (bus)
+   A single Skip-ROM (0xCC) + Convert T (0x44) starts the conversion on all sensors on the bus.
+   Tasks using the same bus join a conversion in progress instead of starting their own,
+   so all tasks can collect their values in the same cycle.
+   Other 1-wire devices supported by ESPEasy (DS2423 counter, DS1990A iButton) ignore Convert T.
+\*********************************************************************************************/
+struct Dallas_BusUser {
+  uint8_t res             = 0; // Resolution of the sensors of this user
+  bool    parasitePowered = false;
+};
+
+struct Dallas_BusData {
+  unsigned long start           = 0; // Start time of last conversion
+  unsigned long ready           = 0; // Time when last conversion is ready
+  uint32_t      conversions     = 0; // Number of conversions started
+  uint32_t      joined          = 0; // Number of times a task joined a conversion in progress
+  uint32_t      failed          = 0; // Number of failed attempts to start a conversion
+  uint8_t       maxResolution   = 0; // Highest resolution of all sensors registered on this bus
+  bool          parasitePowered = false;
+
+  // Sensors registered per user (e.g. task data struct) of the bus.
+  std::map<const void *, Dallas_BusUser> users;
+};
+
+// Register a sensor on the bus, to compute the conversion time of the bus.
+// @param owner  Identifies the user of the bus (e.g. task data struct), to unregister its sensors.
+void          Dallas_registerBusSensor(int8_t      gpio_pin_rx,
+                                       const void *owner,
+                                       uint8_t     res,
+                                       bool        parasitePowered);
+
+// Remove all sensors registered by the owner and recompute the bus conversion settings.
+void          Dallas_unregisterBusSensors(int8_t      gpio_pin_rx,
+                                          const void *owner);
+
+// Return true when a conversion on the bus is started and not yet ready.
+bool          Dallas_busConversionActive(int8_t gpio_pin_rx);
+
+// Start a conversion on all sensors on the bus, or join the conversion in progress.
+// @param joined  Set to true when joining a conversion in progress.
+// @retval  Time when the conversion is ready, or 0 when the bus did not respond.
+unsigned long Dallas_startBusConversion(int8_t gpio_pin_rx,
+                                        int8_t gpio_pin_tx,
+                                        bool & joined);
+
+// Conversion time in msec for the given resolution.
+unsigned long Dallas_conversionTime(uint8_t res);
+
+void          Dallas_show_bus_stats_webform_load(int8_t gpio_pin_rx);
+
 /*********************************************************************************************\
    Variables used to keep track of scanning the bus
    N.B. these should not be shared for simultaneous scans on different pins
@@ -38,6 +38,8 @@
 
 #include "ESPEasy_checks.h"
 
+#include <new> // std::nothrow
+
 #ifdef ESP32
 #include <MD5Builder.h>
 #include <esp_partition.h>
@@ -765,6 +767,11 @@ String LoadTaskSettings(taskIndex_t TaskIndex)
   #endif
 
   START_TIMER
+
+  if (Cache.getCachedExtraTaskSettings(TaskIndex, ExtraTaskSettings)) {
+    STOP_TIMER(LOAD_TASK_SETTINGS_CACHED);
+    return String();
+  }
   ExtraTaskSettings.clear();
   const String result = LoadFromFile(SettingsType::Enum::TaskSettings_Type, TaskIndex, (byte *)&ExtraTaskSettings, sizeof(struct ExtraTaskSettingsStruct));
 
@@ -790,6 +797,10 @@ String LoadTaskSettings(taskIndex_t TaskIndex)
     PluginCall(PLUGIN_GET_DEVICEVALUENAMES, &TempEvent, tmp);
   }
   ExtraTaskSettings.validate();
+
+  if (result.length() == 0) {
+    Cache.cacheExtraTaskSettings(ExtraTaskSettings);
+  }
   STOP_TIMER(LOAD_TASK_SETTINGS);
 
   return result;
@@ -952,6 +963,90 @@ String LoadNotificationSettings(int NotificationIndex, byte *memAddress, int dat
   return LoadFromFile(SettingsType::Enum::NotificationSettings_Type, NotificationIndex, memAddress, datasize);
 }
 
+/********************************************************************************************\
+   Write data to a file in blocks of (at most) one flash page.
+   Blocks are aligned to the page boundaries in the file.
+   When compareFirst is set, the current content of each block is read first and
+   the block is only written when it differs, to reduce flash wear.
+   When data is nullptr, the area is filled with zeroes.
+ \*********************************************************************************************/
+#define FILE_WRITE_BLOCK_SIZE 256
+
+static String writeBlocksToFile(fs::File& f, const char *fname, int index, const byte *data, int datasize, bool compareFirst, size_t& bytesWritten)
+{
+  bytesWritten = 0;
+
+  if (datasize <= 0) {
+    return String();
+  }
+
+  // Allocate on the heap, the stack is already quite full when saving settings.
+  uint8_t *buffer = new (std::nothrow) uint8_t[FILE_WRITE_BLOCK_SIZE];
+
+  if (buffer == nullptr) {
+    // Not enough memory, fall back to writing byte by byte.
+    SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
+
+    for (int x = 0; x < datasize; ++x) {
+      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
+      uint8_t byteToSave = (data == nullptr) ? 0 : data[x];
+      SPIFFS_CHECK(f.write(&byteToSave, 1), fname);
+    }
+    bytesWritten = datasize;
+    return String();
+  }
+
+  const size_t fileSize = compareFirst ? f.size() : 0;
+  String res;
+  int    pos = 0;
+
+  while (pos < datasize && res.length() == 0) {
+    const size_t filePos   = index + pos;
+    size_t       blockSize = FILE_WRITE_BLOCK_SIZE - (filePos % FILE_WRITE_BLOCK_SIZE);
+
+    if (blockSize > static_cast<size_t>(datasize - pos)) {
+      blockSize = datasize - pos;
+    }
+
+    bool mustWrite = true;
+
+    if (compareFirst && ((filePos + blockSize) <= fileSize)) {
+      if (f.seek(filePos, fs::SeekSet) && (f.read(buffer, blockSize) == blockSize)) {
+        if (data == nullptr) {
+          mustWrite = false;
+
+          for (size_t i = 0; i < blockSize && !mustWrite; ++i) {
+            mustWrite = buffer[i] != 0;
+          }
+        } else {
+          mustWrite = memcmp(buffer, data + pos, blockSize) != 0;
+        }
+      }
+    }
+
+    if (mustWrite) {
+      const uint8_t *toWrite = data + pos;
+
+      if (data == nullptr) {
+        memset(buffer, 0, blockSize);
+        toWrite = buffer;
+      }
+
+      if (!f.seek(filePos, fs::SeekSet) || (f.write(toWrite, blockSize) != blockSize)) {
+        res = FileError(__LINE__, fname);
+      } else {
+        bytesWritten += blockSize;
+      }
+    }
+    pos += blockSize;
+
+    // one page processed, do some background tasks
+    delay(0);
+  }
+  delete[] buffer;
+  return res;
+}
+
 /********************************************************************************************\
    Init a file with zeros on file system
  \*********************************************************************************************/
@@ -965,13 +1060,13 @@ String InitFile(const String& fname, int datasize)
   fs::File f = tryOpenFile(fname, "w");
 
   if (f) {
-    for (int x = 0; x < datasize; x++)
-    {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t zero_value = 0;
-      SPIFFS_CHECK(f.write(&zero_value, 1), fname.c_str());
-    }
+    size_t bytesWritten = 0;
+    const String res    = writeBlocksToFile(f, fname.c_str(), 0, nullptr, datasize, false, bytesWritten);
     f.close();
+
+    if (res.length() != 0) {
+      return res;
+    }
   }
 
   // OK
@@ -1038,39 +1133,41 @@ String doSaveToFile(const char *fname, int index, const byte *memAddress, int da
     addLog(LOG_LEVEL_INFO, log);
   }
   #endif
-  delay(1);
-  unsigned long timer = millis() + 50;
-  fs::File f          = tryOpenFile(fname, mode);
+  #ifndef BUILD_NO_DEBUG
+  const unsigned long saveStart = micros();
+  #endif
+  fs::File f = tryOpenFile(fname, mode);
 
   if (f) {
     clearAllCaches();
-    SPIFFS_CHECK(f,                          fname);
-    SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
-    const byte *pointerToByteToSave = memAddress;
-
-    for (int x = 0; x < datasize; x++)
-    {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t byteToSave = *pointerToByteToSave;
-      SPIFFS_CHECK(f.write(&byteToSave, 1), fname);
-      pointerToByteToSave++;
+    SPIFFS_CHECK(f, fname);
 
-      if (x % 256 == 0) {
-        // one page written, do some background tasks
-        timer = millis() + 50;
-        delay(0);
-      }
+    // Only compare with the current content when the file can be read.
+    const bool compareFirst = mode != nullptr && mode[0] == 'r';
+    size_t     bytesWritten = 0;
+    const String res        = writeBlocksToFile(f, fname, index, memAddress, datasize, compareFirst, bytesWritten);
+    f.close();
 
-      if (timeOutReached(timer)) {
-        timer += 50;
-        delay(0);
-      }
+    if (res.length() != 0) {
+      return res;
     }
-    f.close();
     #ifndef BUILD_NO_DEBUG
     if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+      const unsigned long duration = usecPassedSince(saveStart);
       String log = F("FILE : Saved ");
-      log = log + fname;
+      log += fname;
+      log += F(" bytes: ");
+      log += datasize;
+      log += F(" written: ");
+      log += bytesWritten;
+      log += F(" in ");
+      log += duration;
+      log += F(" usec");
+      if (duration > 0) {
+        log += F(" (");
+        log += static_cast<unsigned long>((1000000ULL * datasize) / duration);
+        log += F(" bytes/sec)");
+      }
       addLog(LOG_LEVEL_INFO, log);
     }
     #endif
@@ -1125,15 +1222,13 @@ String ClearInFile(const char *fname, int index, int datasize)
   fs::File f = tryOpenFile(fname, "r+");
 
   if (f) {
-    SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
+    size_t bytesWritten = 0;
+    const String res    = writeBlocksToFile(f, fname, index, nullptr, datasize, true, bytesWritten);
+    f.close();
 
-    for (int x = 0; x < datasize; x++)
-    {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t zero_value = 0;
-      SPIFFS_CHECK(f.write(&zero_value, 1), fname);
+    if (res.length() != 0) {
+      return res;
     }
-    f.close();
   } else {
     #ifndef BUILD_NO_DEBUG
     String log = F("ClearInFile: ");
@@ -1166,7 +1261,6 @@ String LoadFromFile(const char *fname, int offset, byte *memAddress, int datasiz
     addLog(LOG_LEVEL_ERROR, log);
     return log;
   }
-  delay(1);
   START_TIMER;
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("LoadFromFile"));
@@ -1178,7 +1272,7 @@ String LoadFromFile(const char *fname, int offset, byte *memAddress, int datasiz
   f.close();
 
   STOP_TIMER(LOADFILE_STATS);
-  delay(1);
+  delay(0);
 
   return String();
 }
@@ -80,10 +80,8 @@ void run_compiletime_checks() {
   check_size<ExtraTaskSettingsStruct,               472u>();
   check_size<EventStruct,                           96u>(); // Is not stored
 
-  // LogStruct is mainly dependent on the number of lines.
-  // Has to be round up to multiple of 4.
-  const unsigned int LogStructSize = ((12u + 17 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  check_size<LogStruct,                             LogStructSize>(); // Is not stored
+  // LogStruct allocates its buffer on the heap, so its size does not depend on the buffer size.
+  check_size<LogStruct,                             36u>(); // Is not stored
   check_size<DeviceStruct,                          8u>(); // Is not stored
   check_size<ProtocolStruct,                        6u>();
   #ifdef USES_NOTIFIER
@@ -8,6 +8,7 @@
 
 #include "../ESPEasyCore/Serial.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/ESPEasy_time.h"
 
 #include "../Helpers/ESPEasy_FactoryDefault.h"
@@ -126,6 +127,7 @@ void taskClear(taskIndex_t taskIndex, bool save)
   checkRAM(F("taskClear"));
   #endif
   Settings.clearTask(taskIndex);
+  Cache.clearCachedExtraTaskSettings(taskIndex);
   ExtraTaskSettings.clear(); // Invalidate any cached values.
   ExtraTaskSettings.TaskIndex = taskIndex;
 
@@ -1,6 +1,7 @@
 #include "Modbus_RTU.h"
 
 
+#include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "ESPEasy_time_calc.h"
 #include "StringConverter.h"
@@ -29,11 +30,13 @@ void ModbusRTU_struct::reset() {
   for (int i = 0; i < MODBUS_RECEIVE_BUFFER; ++i) {
     _recv_buf[i] = 0xff;
   }
-  _recv_buf_used    = 0;
-  _modbus_address   = MODBUS_BROADCAST_ADDRESS;
-  _reads_pass       = 0;
-  _reads_crc_failed = 0;
-  _reads_nodata     = 0;
+  _recv_buf_used       = 0;
+  _transaction_pending     = false;
+  _transaction_interrupted = false;
+  _modbus_address          = MODBUS_BROADCAST_ADDRESS;
+  _reads_pass          = 0;
+  _reads_crc_failed    = 0;
+  _reads_nodata        = 0;
 }
 
 bool ModbusRTU_struct::init(const ESPEasySerialPort port, const int16_t serial_rx, const int16_t serial_tx, int16_t baudrate, byte address) {
@@ -157,6 +160,7 @@ String ModbusRTU_struct::getDevice_description(byte slaveAddress) {
 // Read from RAM or EEPROM
 void ModbusRTU_struct::buildRead_RAM_EEPROM(byte slaveAddress, byte functionCode,
                                             short startAddress, byte number_bytes) {
+  finishPendingTransaction();
   _sendframe[0]   = slaveAddress;
   _sendframe[1]   = functionCode;
   _sendframe[2]   = (byte)(startAddress >> 8);
@@ -167,6 +171,7 @@ void ModbusRTU_struct::buildRead_RAM_EEPROM(byte slaveAddress, byte functionCode
 
 // Write to the Special Control Register (SCR)
 void ModbusRTU_struct::buildWriteCommandRegister(byte slaveAddress, byte value) {
+  finishPendingTransaction();
   _sendframe[0]   = slaveAddress;
   _sendframe[1]   = MODBUS_CMD_WRITE_RAM;
   _sendframe[2]   = 0;    // Address-Hi SCR  (0x0060)
@@ -177,6 +182,7 @@ void ModbusRTU_struct::buildWriteCommandRegister(byte slaveAddress, byte value)
 }
 
 void ModbusRTU_struct::buildWriteMult16bRegister(byte slaveAddress, uint16_t startAddress, uint16_t value) {
+  finishPendingTransaction();
   _sendframe[0]   = slaveAddress;
   _sendframe[1]   = MODBUS_WRITE_MULTIPLE_REGISTERS;
   _sendframe[2]   = (byte)(startAddress >> 8);
@@ -191,6 +197,7 @@ void ModbusRTU_struct::buildWriteMult16bRegister(byte slaveAddress, uint16_t sta
 
 void ModbusRTU_struct::buildFrame(byte slaveAddress, byte functionCode,
                                   short startAddress, short parameter) {
+  finishPendingTransaction();
   _sendframe[0]   = slaveAddress;
   _sendframe[1]   = functionCode;
   _sendframe[2]   = (byte)(startAddress >> 8);
@@ -202,6 +209,7 @@ void ModbusRTU_struct::buildFrame(byte slaveAddress, byte functionCode,
 
 void ModbusRTU_struct::build_modbus_MEI_frame(byte slaveAddress, byte device_id,
                                               byte object_id) {
+  finishPendingTransaction();
   _sendframe[0] = slaveAddress;
   _sendframe[1] = 0x2B;
   _sendframe[2] = 0x0E;
@@ -413,102 +421,223 @@ void ModbusRTU_struct::logModbusException(byte value) {
    }
  */
 byte ModbusRTU_struct::processCommand() {
+  byte return_value = 0;
+
+  if (!startTransaction()) {
+    return MODBUS_NODATA;
+  }
+
+  while (!pollTransaction(return_value)) {
+    delay(0);
+  }
+  return return_value;
+}
+
+bool ModbusRTU_struct::startTransaction() {
+  if (!isInitialized() || _transaction_pending) {
+    return false;
+  }
+
   // CRC-calculation
-  unsigned int crc =
+  const unsigned int crc =
     ModRTU_CRC(_sendframe, _sendframe_used);
 
   // Note, this number has low and high bytes swapped, so use it accordingly (or
   // swap bytes)
-  byte checksumHi = (byte)((crc >> 8) & 0xFF);
-  byte checksumLo = (byte)(crc & 0xFF);
+  _sendframe[_sendframe_used++] = (byte)(crc & 0xFF);
+  _sendframe[_sendframe_used++] = (byte)((crc >> 8) & 0xFF);
 
-  _sendframe[_sendframe_used++] = checksumLo;
-  _sendframe[_sendframe_used++] = checksumHi;
+  _nrRetriesLeft     = 1;
+  _transaction_start = micros();
+  sendFrame();
+  return true;
+}
 
-  int  nrRetriesLeft = 2;
-  byte return_value  = 0;
+void ModbusRTU_struct::finishPendingTransaction() {
+  if (!_transaction_pending) {
+    return;
+  }
 
-  while (nrRetriesLeft > 0) {
-    return_value = 0;
+  // Wait for the reply, so it cannot be mistaken for the reply to the next frame.
+  // The frame must not be changed before, as it may still be sent again on retry.
+  byte errorcode = 0;
 
-    // Send the byte array
-    startWrite();
-    easySerial->write(_sendframe, _sendframe_used);
+  while (!pollTransaction(errorcode)) {
+    delay(0);
+  }
 
-    // sent all data from buffer
-    easySerial->flush();
-    startRead();
+  // The received data will be overwritten by the next transaction.
+  _transaction_interrupted = true;
+}
 
-    // Read answer from sensor
-    _recv_buf_used = 0;
-    unsigned long timeout    = millis() + _modbus_timeout;
-    bool validPacket         = false;
-    bool invalidDueToTimeout = false;
+void ModbusRTU_struct::sendFrame() {
+  START_TIMER;
 
-    //  idx:    0,   1,   2,   3,   4,   5,   6,   7
-    // send: 0x02,0x03,0x00,0x00,0x00,0x01,0x39,0x84
-    // recv: 0x02,0x03,0x02,0x01,0x57,0xBC,0x2A
+  // Send the byte array
+  startWrite();
+  easySerial->write(_sendframe, _sendframe_used);
 
-    while (!validPacket && !invalidDueToTimeout && _recv_buf_used < MODBUS_RECEIVE_BUFFER) {
-      if (timeOutReached(timeout)) {
-        invalidDueToTimeout = true;
-      }
+  // sent all data from buffer
+  easySerial->flush();
+  startRead();
 
-      while (!invalidDueToTimeout && easySerial->available() && _recv_buf_used < MODBUS_RECEIVE_BUFFER) {
-        if (timeOutReached(timeout)) {
-          invalidDueToTimeout = true;
-        }
-        _recv_buf[_recv_buf_used++] = easySerial->read();
-      }
+  _recv_buf_used       = 0;
+  _transaction_timeout = millis() + _modbus_timeout;
+  _transaction_pending = true;
+  STOP_TIMER(MODBUS_RTU_SEND);
+}
 
-      if (_recv_buf_used > 2) {                                         // got length
-        if (_recv_buf_used >= (3 + _recv_buf[2] + 2)) {                 // got whole pkt
-          crc          = ModRTU_CRC(_recv_buf, _recv_buf_used);         // crc16 is 0 for whole valid pkt
-          validPacket  = (crc == 0) && (_recv_buf[0] == _sendframe[0]); // check crc and address
-          return_value = 0;                                             // reset return value
-        }
-      }
-      delay(0);
+bool ModbusRTU_struct::pollTransaction(byte& errorcode) {
+  if (!_transaction_pending) {
+    if (_transaction_interrupted) {
+      _transaction_interrupted = false;
+      errorcode                = MODBUS_NODATA;
+    } else {
+      errorcode = _last_error;
     }
+    return true;
+  }
 
-    // Check for MODBUS exception
-    if (invalidDueToTimeout) {
-      ++_reads_nodata;
+  //  idx:    0,   1,   2,   3,   4,   5,   6,   7
+  // send: 0x02,0x03,0x00,0x00,0x00,0x01,0x39,0x84
+  // recv: 0x02,0x03,0x02,0x01,0x57,0xBC,0x2A
 
-      if (_recv_buf_used == 0) {
-        return_value = MODBUS_NODATA;
-      } else {
-        return_value = MODBUS_TIMEOUT;
-      }
-    } else if (!validPacket) {
-      ++_reads_crc_failed;
-      return_value = MODBUS_BADCRC;
+  // Only collect what has already been received, do not wait for more.
+  while (easySerial->available() && _recv_buf_used < MODBUS_RECEIVE_BUFFER) {
+    _recv_buf[_recv_buf_used++] = easySerial->read();
+  }
+
+  bool validPacket = false;
+
+  if (_recv_buf_used > 2) {                                            // got length
+    if (_recv_buf_used >= (3 + _recv_buf[2] + 2)) {                    // got whole pkt
+      const unsigned int crc = ModRTU_CRC(_recv_buf, _recv_buf_used);  // crc16 is 0 for whole valid pkt
+      validPacket = (crc == 0) && (_recv_buf[0] == _sendframe[0]) &&  // check crc and address
+                    ((_recv_buf[1] & 0x7F) == _sendframe[1]);          // and function code
+    }
+  }
+
+  const bool invalidDueToTimeout = !validPacket && timeOutReached(_transaction_timeout);
+
+  if (!validPacket && !invalidDueToTimeout && (_recv_buf_used < MODBUS_RECEIVE_BUFFER)) {
+    // Still waiting for the reply
+    return false;
+  }
+
+  byte return_value = 0;
+
+  // Check for MODBUS exception
+  if (invalidDueToTimeout) {
+    ++_reads_nodata;
+
+    if (_recv_buf_used == 0) {
+      return_value = MODBUS_NODATA;
     } else {
-      const byte received_functionCode = _recv_buf[1];
+      return_value = MODBUS_TIMEOUT;
+    }
+  } else if (!validPacket) {
+    ++_reads_crc_failed;
+    return_value = MODBUS_BADCRC;
+  } else {
+    const byte received_functionCode = _recv_buf[1];
 
-      if ((received_functionCode & 0x80) != 0) {
-        return_value = _recv_buf[2];
-      }
-      ++_reads_pass;
-      _reads_nodata = 0;
+    if ((received_functionCode & 0x80) != 0) {
+      return_value = _recv_buf[2];
     }
+    ++_reads_pass;
+    _reads_nodata = 0;
+  }
 
-    switch (return_value) {
-      case MODBUS_EXCEPTION_ACKNOWLEDGE:
-      case MODBUS_EXCEPTION_SLAVE_OR_SERVER_BUSY:
-      case MODBUS_BADCRC:
-      case MODBUS_TIMEOUT:
+  switch (return_value) {
+    case MODBUS_EXCEPTION_ACKNOWLEDGE:
+    case MODBUS_EXCEPTION_SLAVE_OR_SERVER_BUSY:
+    case MODBUS_BADCRC:
+    case MODBUS_TIMEOUT:
+
+      // Bad communication, makes sense to retry.
+      if (_nrRetriesLeft > 0) {
+        --_nrRetriesLeft;
+        sendFrame();
+        return false;
+      }
+      break;
+    default:
+      // When not supported, does not make sense to retry.
+      break;
+  }
+  _transaction_pending = false;
+  _last_error          = return_value;
+  errorcode            = return_value;
+  ADD_TIMER_STAT(MODBUS_RTU_TRANSACTION, usecPassedSince(_transaction_start));
+  return true;
+}
 
-        // Bad communication, makes sense to retry.
-        break;
-      default:
-        nrRetriesLeft = 0; // When not supported, does not make sense to retry.
-        break;
+bool ModbusRTU_struct::isTransactionPending() const {
+  return _transaction_pending;
+}
+
+bool ModbusRTU_struct::startReadHoldingRegisters(short address, byte count) {
+  return startReadRegisters(MODBUS_READ_HOLDING_REGISTERS, address, count);
+}
+
+bool ModbusRTU_struct::startReadInputRegisters(short address, byte count) {
+  return startReadRegisters(MODBUS_READ_INPUT_REGISTERS, address, count);
+}
+
+byte ModbusRTU_struct::readHoldingRegisters(short address, byte count, uint16_t *values) {
+  return readRegisters(MODBUS_READ_HOLDING_REGISTERS, address, count, values);
+}
+
+byte ModbusRTU_struct::readInputRegisters(short address, byte count, uint16_t *values) {
+  return readRegisters(MODBUS_READ_INPUT_REGISTERS, address, count, values);
+}
+
+bool ModbusRTU_struct::startReadRegisters(byte functionCode, short address, byte count) {
+  if ((count == 0) || (count > MODBUS_MAX_REGISTERS_PER_READ) || _transaction_pending) {
+    return false;
+  }
+  buildFrame(_modbus_address, functionCode, address, count);
+  _transaction_interrupted = false;
+  return startTransaction();
+}
+
+byte ModbusRTU_struct::readRegisters(byte functionCode, short address, byte count, uint16_t *values) {
+  if ((count == 0) || (count > MODBUS_MAX_REGISTERS_PER_READ) || (values == nullptr)) {
+    return MODBUS_BADDATA;
+  }
+  buildFrame(_modbus_address, functionCode, address, count);
+  const byte errorcode = processCommand();
+
+  if (errorcode == 0) {
+    if (getRegisters(values, count) != count) {
+      return MODBUS_BADDATA;
     }
-    --nrRetriesLeft;
+    return 0;
   }
-  _last_error = return_value;
-  return return_value;
+  logModbusException(errorcode);
+  return errorcode;
+}
+
+byte ModbusRTU_struct::getRegisters(uint16_t *values, byte maxCount) const {
+  if (_transaction_pending || (_last_error != 0) || (values == nullptr)) {
+    return 0;
+  }
+  const byte functionCode = _recv_buf[1];
+
+  if ((functionCode != MODBUS_READ_HOLDING_REGISTERS) &&
+      (functionCode != MODBUS_READ_INPUT_REGISTERS)) {
+    return 0;
+  }
+  byte count = _recv_buf[2] / 2;
+
+  if (count > maxCount) {
+    count = maxCount;
+  }
+
+  for (byte i = 0; i < count; ++i) {
+    values[i] = (_recv_buf[3 + 2 * i] << 8) | _recv_buf[4 + 2 * i];
+  }
+  return count;
 }
 
 uint32_t ModbusRTU_struct::read_32b_InputRegister(short address) {
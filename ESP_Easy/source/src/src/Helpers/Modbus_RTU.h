@@ -7,6 +7,7 @@
 
 
 #define MODBUS_RECEIVE_BUFFER 256
+#define MODBUS_MAX_REGISTERS_PER_READ 125 // Max. nr of 16 bit registers in a single read request
 #define MODBUS_BROADCAST_ADDRESS 0xFE
 
 #define MODBUS_READ_HOLDING_REGISTERS 0x03
@@ -123,8 +124,46 @@ struct ModbusRTU_struct  {
       return log;
      }
    */
+  // Send the frame and wait for the reply.
   byte     processCommand();
 
+  /*********************************************************************************************\
+  * Non-blocking transactions
+  * startTransaction() sends the frame prepared by one of the build...() functions and
+  * returns without waiting for the reply.
+  * pollTransaction() must be called regularly (e.g. from PLUGIN_FIFTY_PER_SECOND) to collect
+  * the reply. It returns true when the transaction has finished, with the result in errorcode.
+  * The build...() functions first wait for a pending transaction to finish.
+  * Its result is then reported as MODBUS_NODATA, as the reply will be overwritten.
+  \*********************************************************************************************/
+  bool     startTransaction();
+
+  bool     pollTransaction(byte& errorcode);
+
+  bool     isTransactionPending() const;
+
+  // Read a range of consecutive registers using a single request.
+  // Function 3 (0x03) "Read Holding Registers" or 4 (0x04) "Read Input Registers"
+  bool     startReadHoldingRegisters(short address,
+                                     byte  count);
+
+  bool     startReadInputRegisters(short address,
+                                   byte  count);
+
+  // Blocking versions of the range read, return the error code.
+  byte     readHoldingRegisters(short     address,
+                                byte      count,
+                                uint16_t *values);
+
+  byte     readInputRegisters(short     address,
+                              byte      count,
+                              uint16_t *values);
+
+  // Copy the registers of the last successful range read.
+  // Returns the number of registers copied.
+  byte     getRegisters(uint16_t *values,
+                        byte      maxCount) const;
+
   uint32_t read_32b_InputRegister(short address);
 
   uint32_t read_32b_HoldingRegister(short address);
@@ -202,6 +241,21 @@ private:
 
   void startRead();
 
+  // Wait for a pending non-blocking transaction to finish, before a new frame is built.
+  void finishPendingTransaction();
+
+  // Send the frame (incl. CRC) and start waiting for the reply.
+  void sendFrame();
+
+  bool startReadRegisters(byte  functionCode,
+                          short address,
+                          byte  count);
+
+  byte readRegisters(byte      functionCode,
+                     short     address,
+                     byte      count,
+                     uint16_t *values);
+
   byte     _sendframe[12]                   = { 0 };
   byte     _sendframe_used                  = 0;
   byte     _recv_buf[MODBUS_RECEIVE_BUFFER] = { 0 };
@@ -213,6 +267,11 @@ private:
   uint32_t _reads_nodata                    = 0; // This will be reset as soon as a valid packet has been received.
   uint16_t _modbus_timeout                  = 180;
   uint8_t  _last_error                      = 0;
+  uint8_t  _nrRetriesLeft                   = 0;
+  bool     _transaction_pending             = false;
+  bool     _transaction_interrupted         = false; // Pending transaction was finished by a blocking command
+  unsigned long _transaction_timeout        = 0;
+  unsigned long _transaction_start          = 0; // micros() at start of transaction
 
   ESPeasySerial *easySerial = nullptr;
 };
@@ -2,6 +2,7 @@
 
 #include "../../ESPEasy_common.h"
 #include "../Commands/InternalCommands.h"
+#include "../DataStructs/SyslogQueue.h"
 #include "../DataStructs/TimingStats.h"
 #include "../DataTypes/EventValueSource.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
@@ -9,6 +10,7 @@
 #include "../ESPEasyCore/ESPEasyWifi.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
 #include "../Globals/ESPEasy_Scheduler.h"
+#include "../Globals/Logging.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/Nodes.h"
 #include "../Globals/Settings.h"
@@ -65,70 +67,11 @@ void etharp_gratuitous_r(struct netif *netif) {
 
 /*********************************************************************************************\
    Syslog client
+   The line is only queued here, the queued lines are sent from backgroundtasks()
 \*********************************************************************************************/
 void syslog(byte logLevel, const char *message)
 {
-  if ((Settings.Syslog_IP[0] != 0) && NetworkConnected())
-  {
-    IPAddress broadcastIP(Settings.Syslog_IP[0], Settings.Syslog_IP[1], Settings.Syslog_IP[2], Settings.Syslog_IP[3]);
-
-    if (portUDP.beginPacket(broadcastIP, Settings.SyslogPort) == 0) {
-      // problem resolving the hostname or port
-      return;
-    }
-    byte prio = Settings.SyslogFacility * 8;
-
-    if (logLevel == LOG_LEVEL_ERROR) {
-      prio += 3; // syslog error
-    }
-    else if (logLevel == LOG_LEVEL_INFO) {
-      prio += 5; // syslog notice
-    }
-    else {
-      prio += 7;
-    }
-
-    // An RFC3164 compliant message must be formated like :  "<PRIO>[TimeStamp ]Hostname TaskName: Message"
-
-    // Using Settings.Name as the Hostname (Hostname must NOT content space)
-    {
-      String header;
-      String hostname = NetworkCreateRFCCompliantHostname(true);
-      hostname.trim();
-      hostname.replace(' ', '_');
-      header.reserve(16 + hostname.length());
-      char str[8] = { 0 };
-      snprintf_P(str, sizeof(str), PSTR("<%u>"), prio);
-      header  = str;
-      header += hostname;
-      header += F(" EspEasy: ");
-      #ifdef ESP8266
-      portUDP.write(header.c_str(),            header.length());
-      #endif // ifdef ESP8266
-      #ifdef ESP32
-      portUDP.write((uint8_t *)header.c_str(), header.length());
-      #endif // ifdef ESP32
-    }
-    const char *c = message;
-    bool done     = false;
-
-    while (!done) {
-      // Must use PROGMEM aware functions here to process message
-      char ch = pgm_read_byte(c++);
-
-      if (ch == '\0') {
-        done = true;
-      } else {
-        #ifdef ESP8266
-        portUDP.write(ch);
-        #endif // ifdef ESP8266
-        #ifdef ESP32
-        portUDP.write((uint8_t)ch);
-        #endif // ifdef ESP32
-      }
-    }
-    portUDP.endPacket();
-  }
+  syslogQueue.add(logLevel, message);
 }
 
 /*********************************************************************************************\
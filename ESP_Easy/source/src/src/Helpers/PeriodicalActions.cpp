@@ -36,6 +36,8 @@
 #include "../Helpers/StringGenerator_WiFi.h"
 #include "../Helpers/StringProvider.h"
 
+#include "../WebServer/Events.h"
+
 
 #define PLUGIN_ID_MQTT_IMPORT         37
 
@@ -91,6 +93,9 @@ void run10TimesPerSecond() {
   if (NetworkConnected())
       Blynk_Run_c015();
   #endif
+  #ifdef WEBSERVER_EVENTS
+  events_loop();
+  #endif
   #ifndef USE_RTOS_MULTITASKING
     web_server.handleClient();
   #endif
@@ -294,10 +299,23 @@ void processMQTTdelayQueue() {
   if (element == NULL) { return; }
 
   PrepareSend();
-  if (MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained)) {
+
+  // Publish a burst of messages when batching is enabled.
+  // Only the messages published successfully are removed from the queue.
+  const size_t batchCount = MQTTDelayHandler->getBatchCount();
+  size_t nrPublished      = 0;
+
+  while (element != nullptr &&
+         MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained)) {
+    ++nrPublished;
+    element = (nrPublished < batchCount) ? MQTTDelayHandler->getElement(nrPublished) : nullptr;
+  }
+
+  if (nrPublished > 0) {
     if (WiFiEventData.connectionFailures > 0) {
       --WiFiEventData.connectionFailures;
     }
+    MQTTDelayHandler->setBatchInProgress(nrPublished);
     MQTTDelayHandler->markProcessed(true);
   } else {
     MQTTDelayHandler->markProcessed(false);
@@ -305,7 +323,7 @@ void processMQTTdelayQueue() {
 
     if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
       String log = F("MQTT : process MQTT queue not published, ");
-      log += MQTTDelayHandler->sendQueue.size();
+      log += MQTTDelayHandler->size();
       log += F(" items left in queue");
       addLog(LOG_LEVEL_DEBUG, log);
     }
@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 
+#include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/RamTracker.h"
 #include "../Helpers/ESPEasy_math.h"
@@ -26,6 +27,25 @@ bool isError(CalculateReturnCode returnCode) {
   return returnCode != CalculateReturnCode::OK;
 }
 
+String toString(CalculateReturnCode returnCode) {
+  switch (returnCode) {
+    case CalculateReturnCode::ERROR_STACK_OVERFLOW:
+      return F("Stack Overflow");
+    case CalculateReturnCode::ERROR_BAD_OPERATOR:
+      return F("Bad Operator");
+    case CalculateReturnCode::ERROR_PARENTHESES_MISMATCHED:
+      return F("Parenthesis mismatch");
+    case CalculateReturnCode::ERROR_UNKNOWN_TOKEN:
+      return F("Unknown token");
+    case CalculateReturnCode::ERROR_TOKEN_LENGTH_EXCEEDED:
+      return String(F("Exceeded token length (")) + TOKEN_LENGTH + ')';
+    case CalculateReturnCode::OK:
+      // Need to have all cases here so the compiler can warn if we're missing one.
+      break;
+  }
+  return F("");
+}
+
 bool RulesCalculate_t::is_number(char oc, char c)
 {
   // Check if it matches part of a number (identifier)
@@ -293,8 +313,6 @@ unsigned int RulesCalculate_t::op_arg_count(const char c)
 
 CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, double *result)
 {
-  #define TOKEN_LENGTH 25
-  #define OPERATOR_STACK_SIZE 32
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("Calculate"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -476,6 +494,379 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, double *res
   return CalculateReturnCode::OK;
 }
 
+/********************************************************************************************\
+   Compiled expressions
+ \*********************************************************************************************/
+void CalculateProgram::clear()
+{
+  code.clear();
+  constants.clear();
+}
+
+bool CalculateProgram::empty() const
+{
+  return code.empty();
+}
+
+size_t CalculateProgram::getMemorySize() const
+{
+  return code.size() + constants.size() * sizeof(double);
+}
+
+size_t RulesCalculate_t::matchUnaryOperator(const char *pos, char& op)
+{
+  // Function names separated by '|'
+  // Longest names first, so "asin(" is not matched as "sin(".
+  static const char names[] PROGMEM =
+#ifdef USE_TRIGONOMETRIC_FUNCTIONS_RULES
+    "asin_d|acos_d|atan_d|asin|acos|atan|sin_d|cos_d|tan_d|sin|cos|tan|"
+#endif // ifdef USE_TRIGONOMETRIC_FUNCTIONS_RULES
+    "round|sqrt|log|abs|exp|ln|sq|";
+  static const uint8_t ops[] PROGMEM = {
+#ifdef USE_TRIGONOMETRIC_FUNCTIONS_RULES
+    static_cast<uint8_t>(UnaryOperator::ArcSin_d),
+    static_cast<uint8_t>(UnaryOperator::ArcCos_d),
+    static_cast<uint8_t>(UnaryOperator::ArcTan_d),
+    static_cast<uint8_t>(UnaryOperator::ArcSin),
+    static_cast<uint8_t>(UnaryOperator::ArcCos),
+    static_cast<uint8_t>(UnaryOperator::ArcTan),
+    static_cast<uint8_t>(UnaryOperator::Sin_d),
+    static_cast<uint8_t>(UnaryOperator::Cos_d),
+    static_cast<uint8_t>(UnaryOperator::Tan_d),
+    static_cast<uint8_t>(UnaryOperator::Sin),
+    static_cast<uint8_t>(UnaryOperator::Cos),
+    static_cast<uint8_t>(UnaryOperator::Tan),
+#endif // ifdef USE_TRIGONOMETRIC_FUNCTIONS_RULES
+    static_cast<uint8_t>(UnaryOperator::Round),
+    static_cast<uint8_t>(UnaryOperator::Sqrt),
+    static_cast<uint8_t>(UnaryOperator::Log),
+    static_cast<uint8_t>(UnaryOperator::Abs),
+    static_cast<uint8_t>(UnaryOperator::Exp),
+    static_cast<uint8_t>(UnaryOperator::Ln),
+    static_cast<uint8_t>(UnaryOperator::Sq)
+  };
+
+  if (!isalpha(*pos)) {
+    return 0;
+  }
+
+  size_t nameIndex = 0;
+  size_t matched   = 0;
+  bool   mismatch  = false;
+
+  for (size_t i = 0;; ++i) {
+    const char n = pgm_read_byte(names + i);
+
+    if (n == 0) {
+      return 0;
+    }
+
+    if (n == '|') {
+      if (!mismatch && (pos[matched] == '(')) {
+        op = static_cast<char>(pgm_read_byte(ops + nameIndex));
+        return matched;
+      }
+      ++nameIndex;
+      matched  = 0;
+      mismatch = false;
+    } else if (!mismatch) {
+      if (pos[matched] == n) {
+        ++matched;
+      } else {
+        mismatch = true;
+      }
+    }
+  }
+  return 0;
+}
+
+size_t RulesCalculate_t::matchVariable(const char *pos, int& variable)
+{
+  if (*pos != '%') {
+    return 0;
+  }
+
+  if (strncmp_P(pos, PSTR("%value%"), 7) == 0) {
+    variable = static_cast<int>(CalculateVariable::Value);
+    return 7;
+  }
+
+  if (strncmp_P(pos, PSTR("%pvalue%"), 8) == 0) {
+    variable = static_cast<int>(CalculateVariable::PreviousValue);
+    return 8;
+  }
+  return 0;
+}
+
+CalculateReturnCode RulesCalculate_t::compileToken(CalculateProgram& program, const char *token, int& variable, int& depth)
+{
+  if (variable >= 0) {
+    if (token[0] != 0) {
+      // Variable directly followed by a number
+      return CalculateReturnCode::ERROR_UNKNOWN_TOKEN;
+    }
+    program.code.push_back(CALCULATE_OPCODE_VARIABLE);
+    program.code.push_back(static_cast<uint8_t>(variable));
+    variable = -1;
+    ++depth;
+  } else if (token[0] == 0) {
+    return CalculateReturnCode::OK; // Don't bother for an empty string
+  } else if ((is_operator(token[0]) || is_unary_operator(token[0])) && (token[1] == 0)) {
+    program.code.push_back(static_cast<uint8_t>(token[0]));
+
+    // Popping from an empty stack will result in 0.0, so the stack never gets empty here.
+    if (is_operator(token[0])) {
+      depth = (depth > 1) ? depth - 1 : 1;
+    } else if (depth == 0) {
+      depth = 1;
+    }
+  } else {
+    double value = 0.0;
+    validDoubleFromString(token, value);
+
+    // Try to re-use constants already present.
+    size_t index = 0;
+
+    while (index < program.constants.size() && !(program.constants[index] == value)) {
+      ++index;
+    }
+
+    if (index == program.constants.size()) {
+      if (index > 255) {
+        return CalculateReturnCode::ERROR_STACK_OVERFLOW;
+      }
+      program.constants.push_back(value);
+    }
+    program.code.push_back(CALCULATE_OPCODE_CONSTANT);
+    program.code.push_back(static_cast<uint8_t>(index));
+    ++depth;
+  }
+
+  if (depth > STACK_SIZE) {
+    return CalculateReturnCode::ERROR_STACK_OVERFLOW;
+  }
+  return CalculateReturnCode::OK;
+}
+
+CalculateReturnCode RulesCalculate_t::compile(const char *input, CalculateProgram& program, bool allowVariables)
+{
+  const char *strpos = input, *strend = input + strlen(input);
+  char token[TOKEN_LENGTH];
+  char c, oc, *TokenPos = token;
+  char stack[OPERATOR_STACK_SIZE]; // operator stack
+  unsigned int sl       = 0;       // stack length
+  char sc;                         // used for record stack element
+  int  variable         = -1;      // variable in the current token
+  int  newVariable      = -1;
+  int  depth            = 0;       // stack depth needed to evaluate
+  size_t length         = 0;
+  CalculateReturnCode error = CalculateReturnCode::OK;
+
+  program.clear();
+  oc = c = 0;
+
+  if (input[0] == '=') {
+    ++strpos;
+
+    if (strpos < strend) {
+      c = *strpos;
+    }
+  }
+
+  // Same shunting-yard algorithm as doCalculate, but the output queue is stored in the program
+  while (strpos < strend)
+  {
+    if ((TokenPos - &token[0]) >= (TOKEN_LENGTH - 1)) { return CalculateReturnCode::ERROR_TOKEN_LENGTH_EXCEEDED; }
+
+    // read one token from the input stream
+    oc = c;
+    c  = *strpos;
+
+    if ((length = matchUnaryOperator(strpos, c)) != 0) {
+      // Function name, e.g. "sqrt", continue at the opening parenthesis.
+      strpos += length - 1;
+    } else if (allowVariables && ((length = matchVariable(strpos, newVariable)) != 0)) {
+      if ((TokenPos != token) || (variable >= 0)) {
+        // Number or variable directly followed by a variable
+        return CalculateReturnCode::ERROR_UNKNOWN_TOKEN;
+      }
+      variable = newVariable;
+      strpos  += length;
+
+      // Act as if a number was read, so a following '-' is considered an operator.
+      c = '0';
+      continue;
+    }
+
+    if (c != ' ')
+    {
+      // If the token is a number (identifier), then add it to the token queue.
+      if (is_number(oc, c))
+      {
+        *TokenPos = c;
+        ++TokenPos;
+      }
+
+      // If the token is an operator, op1, then:
+      else if (is_operator(c) || is_unary_operator(c))
+      {
+        *(TokenPos) = 0; // Mark end of token string
+        error       = compileToken(program, token, variable, depth);
+        TokenPos    = token;
+
+        if (isError(error)) { return error; }
+
+        while (sl > 0 && sl < (OPERATOR_STACK_SIZE - 1))
+        {
+          sc = stack[sl - 1];
+
+          if (is_operator(sc) &&
+              (
+                (op_left_assoc(c) && (op_preced(c) <= op_preced(sc))) ||
+                (op_preced(c) < op_preced(sc))
+              )
+              )
+          {
+            // Pop op2 off the stack, onto the token queue;
+            *TokenPos = sc;
+            ++TokenPos;
+            *(TokenPos) = 0; // Mark end of token string
+            error       = compileToken(program, token, variable, depth);
+            TokenPos    = token;
+
+            if (isError(error)) { return error; }
+            sl--;
+          }
+          else {
+            break;
+          }
+        }
+
+        // push op1 onto the stack.
+        stack[sl] = c;
+        ++sl;
+      }
+
+      // If the token is a left parenthesis, then push it onto the stack.
+      else if (c == '(')
+      {
+        if (sl >= OPERATOR_STACK_SIZE) { return CalculateReturnCode::ERROR_STACK_OVERFLOW; }
+        stack[sl] = c;
+        ++sl;
+      }
+
+      // If the token is a right parenthesis:
+      else if (c == ')')
+      {
+        bool pe = false;
+
+        // Until the token at the top of the stack is a left parenthesis,
+        // pop operators off the stack onto the token queue
+        while (sl > 0)
+        {
+          *(TokenPos) = 0; // Mark end of token string
+          error       = compileToken(program, token, variable, depth);
+          TokenPos    = token;
+
+          if (isError(error)) { return error; }
+
+          if (sl > OPERATOR_STACK_SIZE) { return CalculateReturnCode::ERROR_STACK_OVERFLOW; }
+          sc = stack[sl - 1];
+
+          if (sc == '(')
+          {
+            pe = true;
+            break;
+          }
+          else
+          {
+            *TokenPos = sc;
+            ++TokenPos;
+            sl--;
+          }
+        }
+
+        // If the stack runs out without finding a left parenthesis, then there are mismatched parentheses.
+        if (!pe) {
+          return CalculateReturnCode::ERROR_PARENTHESES_MISMATCHED;
+        }
+
+        // Pop the left parenthesis from the stack, but not onto the token queue.
+        sl--;
+      }
+      else {
+        return CalculateReturnCode::ERROR_UNKNOWN_TOKEN;
+      }
+    }
+    ++strpos;
+  }
+
+  // When there are no more tokens to read:
+  // While there are still operator tokens in the stack:
+  while (sl > 0)
+  {
+    sc = stack[sl - 1];
+
+    if ((sc == '(') || (sc == ')')) {
+      return CalculateReturnCode::ERROR_PARENTHESES_MISMATCHED;
+    }
+
+    *(TokenPos) = 0; // Mark end of token string
+    error       = compileToken(program, token, variable, depth);
+    TokenPos    = token;
+
+    if (isError(error)) { return error; }
+    *TokenPos = sc;
+    ++TokenPos;
+    --sl;
+  }
+
+  *(TokenPos) = 0; // Mark end of token string
+  return compileToken(program, token, variable, depth);
+}
+
+CalculateReturnCode RulesCalculate_t::evaluate(const CalculateProgram& program, const double *variables, double *result)
+{
+  CalculateReturnCode ret = CalculateReturnCode::OK;
+  const size_t nrBytes    = program.code.size();
+
+  sp = globalstack - 1;
+
+  for (size_t i = 0; i < nrBytes && !isError(ret); ++i) {
+    const char opcode = static_cast<char>(program.code[i]);
+
+    switch (opcode) {
+      case CALCULATE_OPCODE_CONSTANT:
+        ret = push(program.constants[program.code[++i]]);
+        break;
+      case CALCULATE_OPCODE_VARIABLE:
+      {
+        const uint8_t index = program.code[++i];
+        ret = push(variables == nullptr ? 0.0 : variables[index]);
+        break;
+      }
+      default:
+
+        if (is_operator(opcode)) {
+          const double second = pop();
+          const double first  = pop();
+          ret = push(apply_operator(opcode, first, second));
+        } else {
+          const double first = pop();
+          ret = push(apply_unary_operator(opcode, first));
+        }
+        break;
+    }
+  }
+
+  if (isError(ret)) {
+    *result = 0;
+    return ret;
+  }
+  *result = (sp == (globalstack - 1)) ? 0.0 : *sp;
+  return ret;
+}
+
 void preProcessReplace(String& input, UnaryOperator op) {
   String find = toString(op);
 
@@ -563,6 +954,19 @@ String toString(UnaryOperator op)
   return find;
 }
 
+CalculateReturnCode RulesCalculate_t::compileAndEvaluate(const char *input, double *result)
+{
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("Calculate"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+  const CalculateReturnCode returnCode = compile(input, _program, false);
+
+  if (isError(returnCode)) {
+    return returnCode;
+  }
+  return evaluate(_program, nullptr, result);
+}
+
 String RulesCalculate_t::preProces(const String& input)
 {
   String preprocessed = input;
@@ -638,34 +1042,22 @@ int CalculateParam(const String& TmpStr) {
 CalculateReturnCode Calculate(const String& input,
                               double      & result)
 {
+  START_TIMER
+  #ifdef USE_LEGACY_RULES_CALCULATE
   CalculateReturnCode returnCode = RulesCalculate.doCalculate(
     RulesCalculate_t::preProces(input).c_str(),
     &result);
+  #else // ifdef USE_LEGACY_RULES_CALCULATE
+  CalculateReturnCode returnCode = RulesCalculate.compileAndEvaluate(
+    input.c_str(),
+    &result);
+  #endif // ifdef USE_LEGACY_RULES_CALCULATE
+  STOP_TIMER(RULES_CALCULATE_STATS);
 
   if (isError(returnCode)) {
     if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
       String log = F("Calculate: ");
-
-      switch (returnCode) {
-        case CalculateReturnCode::ERROR_STACK_OVERFLOW:
-          log += F("Stack Overflow");
-          break;
-        case CalculateReturnCode::ERROR_BAD_OPERATOR:
-          log += F("Bad Operator");
-          break;
-        case CalculateReturnCode::ERROR_PARENTHESES_MISMATCHED:
-          log += F("Parenthesis mismatch");
-          break;
-        case CalculateReturnCode::ERROR_UNKNOWN_TOKEN:
-          log += F("Unknown token");
-          break;
-        case CalculateReturnCode::ERROR_TOKEN_LENGTH_EXCEEDED:
-          log += String(F("Exceeded token length (")) + TOKEN_LENGTH + ')';
-          break;
-        case CalculateReturnCode::OK:
-          // Already handled, but need to have all cases here so the compiler can warn if we're missing one.
-          break;
-      }
+      log += toString(returnCode);
 
       #ifndef BUILD_NO_DEBUG
       log += F(" input: ");
@@ -4,11 +4,15 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <vector>
+
 /********************************************************************************************\
    Calculate function for simple expressions
  \*********************************************************************************************/
 #define STACK_SIZE 10 // was 50
 #define TOKEN_MAX 20
+#define TOKEN_LENGTH 25
+#define OPERATOR_STACK_SIZE 32
 
 enum class CalculateReturnCode {
   OK                           = 0,
@@ -19,7 +23,9 @@ enum class CalculateReturnCode {
   ERROR_TOKEN_LENGTH_EXCEEDED  = 5
 };
 
-bool isError(CalculateReturnCode returnCode);
+bool   isError(CalculateReturnCode returnCode);
+
+String toString(CalculateReturnCode returnCode);
 
 /********************************************************************************************\
    Special char definitions to represent multi character operators
@@ -49,6 +55,32 @@ enum class UnaryOperator  {
   ArcTan_d   // Arc Tangent (degree)
 };
 
+/********************************************************************************************\
+   Compiled expression in RPN order.
+   Operators are stored as their (single char) operator code.
+   Numerical values are parsed at compile time and stored in a separate table.
+ \*********************************************************************************************/
+#define CALCULATE_OPCODE_CONSTANT  1 // Next byte is the index in the constants table
+#define CALCULATE_OPCODE_VARIABLE  2 // Next byte is the index of the variable
+
+enum class CalculateVariable : uint8_t {
+  Value         = 0, // %value%
+  PreviousValue = 1, // %pvalue%
+
+  NrVariables
+};
+
+struct CalculateProgram {
+  void   clear();
+
+  bool   empty() const;
+
+  size_t getMemorySize() const;
+
+  std::vector<uint8_t>code;
+  std::vector<double> constants;
+};
+
 void   preProcessReplace(String      & input,
                          UnaryOperator op);
 bool   angleDegree(UnaryOperator op);
@@ -58,6 +90,7 @@ class RulesCalculate_t {
 private:
 
   double globalstack[STACK_SIZE];
+  CalculateProgram _program; // Used by compileAndEvaluate
   double *sp     = globalstack - 1;
   double *sp_max = &globalstack[STACK_SIZE - 1];
 
@@ -86,6 +119,24 @@ private:
 
   CalculateReturnCode RPNCalculate(char *token);
 
+  // Add the token to the compiled program.
+  // @param variable  Index of the variable to add, or -1 when token is not a variable.
+  // @param depth     Keeps track of the max. stack depth needed to evaluate the program.
+  CalculateReturnCode compileToken(CalculateProgram& program,
+                                   const char       *token,
+                                   int             & variable,
+                                   int             & depth);
+
+  // Match a unary operator written as function name, e.g. "sqrt("
+  // Return the length of the function name, or 0 when not matched.
+  static size_t matchUnaryOperator(const char *pos,
+                                   char      & op);
+
+  // Match %value% or %pvalue%
+  // Return the length of the variable, or 0 when not matched.
+  static size_t matchVariable(const char *pos,
+                              int       & variable);
+
   // operators
   // precedence   operators         associativity
   // 3            !                 right to left
@@ -102,6 +153,29 @@ public:
   CalculateReturnCode doCalculate(const char *input,
                                   double     *result);
 
+  // Compile the expression into a program which can be evaluated multiple times.
+  // Unlike doCalculate, the input does not need to be pre-processed.
+  // @param allowVariables  Accept %value% and %pvalue% as variables.
+  //   Variables are evaluated using their full precision, not rounded to 2 decimals.
+  //   A variable is a single operand, also when its value is negative.
+  //   This differs from replacing the variable by its value in the formula string,
+  //   where a leading '-' is parsed as an operator with lower precedence than '^'.
+  //   For example with %value% = -3, "%value%^2" results in 9, not -9 as "-3^2" does.
+  CalculateReturnCode compile(const char       *input,
+                              CalculateProgram& program,
+                              bool              allowVariables);
+
+  // Evaluate a compiled program.
+  // @param variables  Values for the variables used in the program, may be nullptr when no variables are used.
+  CalculateReturnCode evaluate(const CalculateProgram& program,
+                               const double           *variables,
+                               double                 *result);
+
+  // Compile and evaluate the expression without variables.
+  // The compiled program is kept in an internal buffer to prevent re-allocations.
+  CalculateReturnCode compileAndEvaluate(const char *input,
+                                         double     *result);
+
   // Try to replace multi byte operators with single character ones.
   // For example log, sin, cos, tan.
   static String preProces(const String& input);
@@ -111,6 +185,8 @@ extern RulesCalculate_t RulesCalculate;
 
 /*******************************************************************************************
 * Helper functions to actually interact with the rules calculation functions.
+* Define USE_LEGACY_RULES_CALCULATE to use the string pre-processing and
+* token based evaluation (doCalculate) instead of the compiled program.
 * *****************************************************************************************/
 
 int                 CalculateParam(const String& TmpStr);
@@ -18,6 +18,8 @@
 #include "../Helpers/PeriodicalActions.h"
 #include "../Helpers/PortStatus.h"
 
+#include <utility> // std::swap
+
 
 //#define TIMER_ID_SHIFT    28   // Must be decreased as soon as timers below reach 15
 
@@ -646,11 +648,7 @@ unsigned long ESPEasy_Scheduler::createRulesTimerId(unsigned int timerIndex) {
 
 static bool checkRulesTimerIndex(unsigned int timerIndex) {
   if ((timerIndex > RULES_TIMER_MAX) || (timerIndex == 0)) {
-    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-      String log = F("TIMER: invalid timer number ");
-      log += timerIndex;
-      addLog(LOG_LEVEL_ERROR, log);
-    }
+    addLogFormat(LOG_LEVEL_ERROR, LogFormat::Timer_InvalidNumber, timerIndex);
     return false;
   }
   return true;
@@ -1006,28 +1004,14 @@ void ESPEasy_Scheduler::schedule_plugin_task_event_timer(deviceIndex_t DeviceInd
   }
 }
 
-void ESPEasy_Scheduler::schedule_mqtt_plugin_import_event_timer(deviceIndex_t   DeviceIndex,
-                                                                taskIndex_t     TaskIndex,
-                                                                byte            Function,
-                                                                char           *c_topic,
-                                                                byte           *b_payload,
-                                                                unsigned int    length) {
-  if (validDeviceIndex(DeviceIndex)) {
-    // Emplace empty event in the queue first and the fill it.
-    // This makes sure the relatively large event will not be in memory twice.
+void ESPEasy_Scheduler::schedule_mqtt_plugin_import_event_timer(deviceIndex_t                        DeviceIndex,
+                                                                taskIndex_t                          TaskIndex,
+                                                                byte                                 Function,
+                                                                const MQTT_inbound_message_ptr_type& message) {
+  if (validDeviceIndex(DeviceIndex) && message) {
+    // Only a reference to the shared message is kept, topic and payload are not copied.
     const unsigned long mixedId = createSystemEventMixedId(PluginPtrType::TaskPlugin, DeviceIndex, static_cast<byte>(Function));
-    ScheduledEventQueue.emplace_back(mixedId, EventStruct(TaskIndex));
-    ScheduledEventQueue.back().event.String1 = c_topic;
-
-    String& payload = ScheduledEventQueue.back().event.String2;
-    if (!payload.reserve(length)) {
-      addLog(LOG_LEVEL_ERROR, F("MQTT : Out of Memory! Cannot process MQTT message"));
-    }
-
-    for (unsigned int i = 0; i < length; ++i) {
-      char c = static_cast<char>(*(b_payload + i));
-      payload += c;
-    }
+    ScheduledEventQueue.emplace_back(mixedId, EventStruct(TaskIndex), message);
   }
 }
 
@@ -1052,27 +1036,13 @@ unsigned long ESPEasy_Scheduler::createSystemEventMixedId(PluginPtrType ptr_type
   return getMixedId(SYSTEM_EVENT_QUEUE, subId);
 }
 
-void ESPEasy_Scheduler::schedule_mqtt_controller_event_timer(protocolIndex_t ProtocolIndex,
-                                                             CPlugin::Function Function,
-                                                             char           *c_topic,
-                                                             byte           *b_payload,
-                                                             unsigned int    length) {
-  if (validProtocolIndex(ProtocolIndex)) {
-    // Emplace empty event in the queue first and the fill it.
-    // This makes sure the relatively large event will not be in memory twice.
+void ESPEasy_Scheduler::schedule_mqtt_controller_event_timer(protocolIndex_t                      ProtocolIndex,
+                                                             CPlugin::Function                    Function,
+                                                             const MQTT_inbound_message_ptr_type& message) {
+  if (validProtocolIndex(ProtocolIndex) && message) {
+    // Only a reference to the shared message is kept, topic and payload are not copied.
     const unsigned long mixedId = createSystemEventMixedId(PluginPtrType::ControllerPlugin, ProtocolIndex, static_cast<byte>(Function));
-    ScheduledEventQueue.emplace_back(mixedId, EventStruct());
-    ScheduledEventQueue.back().event.String1 = c_topic;
-
-    String& payload = ScheduledEventQueue.back().event.String2;
-    if (!payload.reserve(length)) {
-      addLog(LOG_LEVEL_ERROR, F("MQTT : Out of Memory! Cannot process MQTT message"));
-    }
-
-    for (unsigned int i = 0; i < length; ++i) {
-      char c = static_cast<char>(*(b_payload + i));
-      payload += c;
-    }
+    ScheduledEventQueue.emplace_back(mixedId, EventStruct(), message);
   }
 }
 
@@ -1101,18 +1071,32 @@ void ESPEasy_Scheduler::process_system_event_queue() {
   // Else the line string could be used.
   String tmpString;
 
+  EventStructCommandWrapper& front = ScheduledEventQueue.front();
+
+  if (front.mqttMessage) {
+    // Move the shared MQTT message into the event, without copying.
+    std::swap(front.event.String1, front.mqttMessage->topic);
+    std::swap(front.event.String2, front.mqttMessage->payload);
+  }
+
   switch (ptr_type) {
     case PluginPtrType::TaskPlugin:
-      LoadTaskSettings(ScheduledEventQueue.front().event.TaskIndex);
-      Plugin_ptr[Index](Function, &ScheduledEventQueue.front().event, tmpString);
+      LoadTaskSettings(front.event.TaskIndex);
+      Plugin_ptr[Index](Function, &front.event, tmpString);
       break;
     case PluginPtrType::ControllerPlugin:
-      CPluginCall(Index, static_cast<CPlugin::Function>(Function), &ScheduledEventQueue.front().event, tmpString);
+      CPluginCall(Index, static_cast<CPlugin::Function>(Function), &front.event, tmpString);
       break;
     case PluginPtrType::NotificationPlugin:
-      NPlugin_ptr[Index](static_cast<NPlugin::Function>(Function), &ScheduledEventQueue.front().event, tmpString);
+      NPlugin_ptr[Index](static_cast<NPlugin::Function>(Function), &front.event, tmpString);
       break;
   }
+
+  if (front.mqttMessage) {
+    // Hand the message back for the next event sharing it.
+    std::swap(front.event.String1, front.mqttMessage->topic);
+    std::swap(front.event.String2, front.mqttMessage->payload);
+  }
   ScheduledEventQueue.pop_front();
 }
 
@@ -4,6 +4,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../DataStructs/EventStructCommandWrapper.h"
+#include "../DataStructs/MQTT_inbound_message.h"
 #include "../DataStructs/SystemTimerStruct.h"
 #include "../DataTypes/ProtocolIndex.h"
 #include "../Helpers/msecTimerHandlerStruct.h"
@@ -234,23 +235,19 @@ public:
                                         byte                Function,
                                         struct EventStruct *event);
 
-  void schedule_mqtt_plugin_import_event_timer(deviceIndex_t   DeviceIndex,
-                                               taskIndex_t     TaskIndex,
-                                               byte            Function,
-                                               char           *c_topic,
-                                               byte           *b_payload,
-                                               unsigned int    length);
+  void schedule_mqtt_plugin_import_event_timer(deviceIndex_t                        DeviceIndex,
+                                               taskIndex_t                          TaskIndex,
+                                               byte                                 Function,
+                                               const MQTT_inbound_message_ptr_type& message);
 
 
   void schedule_controller_event_timer(protocolIndex_t     ProtocolIndex,
                                        byte                Function,
                                        struct EventStruct *event);
 
-  void schedule_mqtt_controller_event_timer(protocolIndex_t ProtocolIndex,
-                                            CPlugin::Function Function,
-                                            char           *c_topic,
-                                            byte           *b_payload,
-                                            unsigned int    length);
+  void schedule_mqtt_controller_event_timer(protocolIndex_t                      ProtocolIndex,
+                                            CPlugin::Function                    Function,
+                                            const MQTT_inbound_message_ptr_type& message);
 
   void schedule_notification_event_timer(byte                NotificationProtocolIndex,
                                          NPlugin::Function   Function,
@@ -38,122 +38,305 @@ String parseTemplate_padded(String& tmpString, byte minimal_lineSize)
   return parseTemplate_padded(tmpString, minimal_lineSize, false);
 }
 
-String parseTemplate_padded(String& tmpString, byte minimal_lineSize, bool useURLencode)
+// Format a custom variable as used in [var#N] and [int#N]
+static String formatCustomVariable(unsigned int varNum, bool asInt, bool hasFormat)
 {
-  #ifndef BUILD_NO_RAM_TRACKER
-  checkRAM(F("parseTemplate_padded"));
-  #endif // ifndef BUILD_NO_RAM_TRACKER
-  START_TIMER
+  unsigned char nr_decimals = maxNrDecimals_double(getCustomFloatVar(varNum));
+  bool trimTrailingZeros    = true;
 
-  // Keep current loaded taskSettings to restore at the end.
-  byte   currentTaskIndex = ExtraTaskSettings.TaskIndex;
-  String newString;
+  if (asInt) {
+    nr_decimals = 0;
+  } else if (hasFormat)
+  {
+    // There is some formatting here, so do not throw away decimals
+    trimTrailingZeros = false;
+  }
+  String value = doubleToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
 
-  newString.reserve(minimal_lineSize); // Our best guess of the new size.
+  value.trim();
+  return value;
+}
+
+// Replace a single [deviceName#valueName#format] and append the result to newString.
+static void parseTemplate_placeholder(String      & newString,
+                                      const String& deviceName,
+                                      const String& valueName,
+                                      String      & format,
+                                      byte          minimal_lineSize,
+                                      const String& tmpString)
+{
+  // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
+  if (deviceName.equals(F("plugin")))
+  {
+    // Handle a plugin request.
+    // For example: "[Plugin#GPIO#Pinstate#N]"
+    // The command is stored in valueName & format
+    String command;
+    command.reserve(valueName.length() + format.length() + 1);
+    command  = valueName;
+    command += '#';
+    command += format;
+    command.replace('#', ',');
+
+    if (PluginCall(PLUGIN_REQUEST, 0, command))
+    {
+      // Do not call transformValue here.
+      // The "format" is not empty so must not call the formatter function.
+      newString += command;
+    }
+  }
+  else if (deviceName.equals(F("var")) || deviceName.equals(F("int")))
+  {
+    // Address an internal variable either as float or as int
+    // For example: Let,10,[VAR#9]
+    unsigned int varNum;
+
+    if (validUIntFromString(valueName, varNum)) {
+      String value = formatCustomVariable(varNum, deviceName.equals(F("int")), format.length() != 0);
+      transformValue(newString, minimal_lineSize, value, format, tmpString);
+    }
+  }
+  else
+  {
+    // Address a value from a plugin.
+    // For example: "[bme#temp]"
+    // If value name is unknown, run a PLUGIN_GET_CONFIG command.
+    // For example: "[<taskname>#getLevel]"
+    taskIndex_t taskIndex = findTaskIndexByName(deviceName);
+
+    if (validTaskIndex(taskIndex) && Settings.TaskDeviceEnabled[taskIndex]) {
+      byte valueNr = findDeviceValueIndexByName(valueName, taskIndex);
+
+      if (valueNr != VARS_PER_TASK) {
+        // here we know the task and value, so find the uservar
+        // Try to format and transform the values
+        bool   isvalid;
+        String value = formatUserVar(taskIndex, valueNr, isvalid);
+
+        if (isvalid) {
+          transformValue(newString, minimal_lineSize, value, format, tmpString);
+        }
+      } else {
+        // try if this is a get config request
+        struct EventStruct TempEvent(taskIndex);
+        String tmpName = valueName;
 
+        if (PluginCall(PLUGIN_GET_CONFIG, &TempEvent, tmpName))
+        {
+          transformValue(newString, minimal_lineSize, tmpName, format, tmpString);
+        }
+      }
+    }
+  }
+}
 
-  if (parseTemplate_CallBack_ptr != nullptr) {
-    parseTemplate_CallBack_ptr(tmpString, useURLencode);
+// Locate all [...#...] in the template and resolve the task/value index or variable number.
+// Return false when the template cannot be kept in the parsed template cache.
+static bool parseTemplate_compile(const String& tmpString, ParsedTemplateCache::ParsedTemplate& parsed)
+{
+  if (tmpString.length() >= 0xFFFF) {
+    // Positions are stored as uint16_t
+    return false;
   }
-  parseSystemVariables(tmpString, useURLencode);
 
+  parsed.hasSystemVariables = tmpString.indexOf('%') != -1;
 
   int startpos = 0;
-  int lastStartpos = 0;
-  int endpos = 0;
+  int endpos   = 0;
   String deviceName, valueName, format;
 
   while (findNextDevValNameInString(tmpString, startpos, endpos, deviceName, valueName, format)) {
-    // First copy all upto the start of the [...#...] part to be replaced.
-    newString += tmpString.substring(lastStartpos, startpos);
-
-    // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
-    if (deviceName.equals(F("plugin")))
-    {
-      // Handle a plugin request.
-      // For example: "[Plugin#GPIO#Pinstate#N]"
-      // The command is stored in valueName & format
-      String command;
-      command.reserve(valueName.length() + format.length() + 1);
-      command  = valueName;
-      command += '#';
-      command += format;
-      command.replace('#', ',');
-
-      if (PluginCall(PLUGIN_REQUEST, 0, command))
-      {
-        // Do not call transformValue here.
-        // The "format" is not empty so must not call the formatter function.
-        newString += command;
+    for (int i = startpos; i < endpos; ++i) {
+      if (tmpString[i] == '%') {
+        // System variables are replaced before looking for [...#...],
+        // so this one may refer to another task or value each time.
+        return false;
       }
     }
-    else if (deviceName.equals(F("var")) || deviceName.equals(F("int")))
-    {
-      // Address an internal variable either as float or as int
-      // For example: Let,10,[VAR#9]
-      unsigned int varNum;
 
-      if (validUIntFromString(valueName, varNum)) {
-        unsigned char nr_decimals = maxNrDecimals_double(getCustomFloatVar(varNum));
-        bool trimTrailingZeros    = true;
+    if (parsed.hasSystemVariables && (format.indexOf('R') != -1)) {
+      // Right justify uses the length of the template with system variables replaced.
+      return false;
+    }
+    parsed.placeholders.emplace_back(startpos, endpos);
+    ParsedTemplateCache::Placeholder& placeholder = parsed.placeholders.back();
+
+    if (deviceName.equals(F("var")) || deviceName.equals(F("int"))) {
+      if (validUIntFromString(valueName, placeholder.varNum)) {
+        placeholder.type = deviceName.equals(F("int")) ?
+                           ParsedTemplateCache::PlaceholderType::IntVariable :
+                           ParsedTemplateCache::PlaceholderType::Variable;
+      }
+    } else if (!deviceName.equals(F("plugin"))) {
+      const taskIndex_t taskIndex = findTaskIndexByName(deviceName);
+
+      if (validTaskIndex(taskIndex) && Settings.TaskDeviceEnabled[taskIndex]) {
+        const byte valueNr = findDeviceValueIndexByName(valueName, taskIndex);
 
-        if (deviceName.equals(F("int"))) {
-          nr_decimals = 0;
-        } else if (format.length() != 0)
-        {
-          // There is some formatting here, so do not throw away decimals
-          trimTrailingZeros = false;
+        if (valueNr != VARS_PER_TASK) {
+          placeholder.type      = ParsedTemplateCache::PlaceholderType::TaskValue;
+          placeholder.taskIndex = taskIndex;
+          placeholder.valueNr   = valueNr;
         }
-        String value = doubleToString(getCustomFloatVar(varNum), nr_decimals, trimTrailingZeros);
-        value.trim();
-        transformValue(newString, minimal_lineSize, value, format, tmpString);
       }
     }
-    else
-    {
-      // Address a value from a plugin.
-      // For example: "[bme#temp]"
-      // If value name is unknown, run a PLUGIN_GET_CONFIG command.
-      // For example: "[<taskname>#getLevel]"
-      taskIndex_t taskIndex = findTaskIndexByName(deviceName);
 
-      if (validTaskIndex(taskIndex) && Settings.TaskDeviceEnabled[taskIndex]) {
-        byte valueNr = findDeviceValueIndexByName(valueName, taskIndex);
+    if (placeholder.type == ParsedTemplateCache::PlaceholderType::Dynamic) {
+      parsed.hasDynamicPlaceholders = true;
+    } else {
+      std::swap(placeholder.format, format);
+    }
+    startpos = endpos + 1;
+  }
+  return !parsed.placeholders.empty();
+}
 
-        if (valueNr != VARS_PER_TASK) {
-          // here we know the task and value, so find the uservar
-          // Try to format and transform the values
+// Append the part of the template in between placeholders.
+static void parseTemplate_appendLiteral(String      & newString,
+                                        const String& tmpString,
+                                        int           startpos,
+                                        int           endpos,
+                                        bool          hasSystemVariables,
+                                        bool          useURLencode)
+{
+  if (startpos >= endpos) {
+    return;
+  }
+
+  if (!hasSystemVariables) {
+    newString += tmpString.substring(startpos, endpos);
+    return;
+  }
+  String literal = tmpString.substring(startpos, endpos);
+
+  parseSystemVariables(literal, useURLencode);
+  newString += literal;
+}
+
+// Render a template using the placeholders located by parseTemplate_compile()
+static void parseTemplate_render(String                                   & newString,
+                                 const String                             & tmpString,
+                                 const ParsedTemplateCache::ParsedTemplate& parsed,
+                                 byte                                       minimal_lineSize,
+                                 bool                                       useURLencode)
+{
+  int lastStartpos = 0;
+
+  for (auto it = parsed.placeholders.begin(); it != parsed.placeholders.end(); ++it) {
+    parseTemplate_appendLiteral(newString, tmpString, lastStartpos, it->start, parsed.hasSystemVariables, useURLencode);
+
+    switch (it->type) {
+      case ParsedTemplateCache::PlaceholderType::TaskValue:
+      {
+        if (Settings.TaskDeviceEnabled[it->taskIndex]) {
           bool   isvalid;
-          String value = formatUserVar(taskIndex, valueNr, isvalid);
+          String value = formatUserVar(it->taskIndex, it->valueNr, isvalid);
 
           if (isvalid) {
+            String format = it->format; // transformValue may alter the format
             transformValue(newString, minimal_lineSize, value, format, tmpString);
           }
-        } else {
-          // try if this is a get config request
-          struct EventStruct TempEvent(taskIndex);
-          String tmpName = valueName;
+        }
+        break;
+      }
+      case ParsedTemplateCache::PlaceholderType::Variable:
+      case ParsedTemplateCache::PlaceholderType::IntVariable:
+      {
+        String value = formatCustomVariable(
+          it->varNum,
+          it->type == ParsedTemplateCache::PlaceholderType::IntVariable,
+          it->format.length() != 0);
+        String format = it->format;
+        transformValue(newString, minimal_lineSize, value, format, tmpString);
+        break;
+      }
+      case ParsedTemplateCache::PlaceholderType::Dynamic:
+      {
+        int startpos = it->start;
+        int endpos   = it->end;
+        String deviceName, valueName, format;
 
-          if (PluginCall(PLUGIN_GET_CONFIG, &TempEvent, tmpName))
-          {
-            transformValue(newString, minimal_lineSize, tmpName, format, tmpString);
-          }
+        if (findNextDevValNameInString(tmpString, startpos, endpos, deviceName, valueName, format)) {
+          parseTemplate_placeholder(newString, deviceName, valueName, format, minimal_lineSize, tmpString);
         }
+        delay(0);
+        break;
       }
     }
+    lastStartpos = it->end + 1;
+  }
+  parseTemplate_appendLiteral(newString, tmpString, lastStartpos, tmpString.length(), parsed.hasSystemVariables, useURLencode);
+}
 
+String parseTemplate_padded(String& tmpString, byte minimal_lineSize, bool useURLencode)
+{
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("parseTemplate_padded"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+  START_TIMER
+
+  // Keep current loaded taskSettings to restore at the end.
+  byte   currentTaskIndex = ExtraTaskSettings.TaskIndex;
+  String newString;
+
+  newString.reserve(minimal_lineSize); // Our best guess of the new size.
 
-    // Conversion is done (or impossible) for the found "[...#...]"
-    // Continue with the next one.
-    lastStartpos = endpos + 1;
-    startpos     = endpos + 1;
+  // Templates with [...#...] are split once and kept in the cache.
+  // This cannot be done when a callback function may alter the template first.
+  // Only templates seen before are compiled, to keep templates used only once out of the cache.
+  const ParsedTemplateCache::ParsedTemplate *parsed = nullptr;
 
-    // This may have taken some time, so call delay()
-    delay(0);
+  if ((parseTemplate_CallBack_ptr == nullptr) && (tmpString.indexOf('[') != -1)) {
+    parsed = Cache.parsedTemplates.get(tmpString);
+
+    if ((parsed == nullptr) && Cache.parsedTemplates.seenBefore(tmpString)) {
+      ParsedTemplateCache::ParsedTemplate compiled;
+
+      if (parseTemplate_compile(tmpString, compiled)) {
+        Cache.parsedTemplates.add(tmpString, std::move(compiled));
+        parsed = Cache.parsedTemplates.get(tmpString);
+      }
+    }
   }
 
-  // Copy the rest of the string (or all if no replacements were done)
-  newString += tmpString.substring(lastStartpos);
+  if (parsed != nullptr) {
+    if (parsed->hasDynamicPlaceholders) {
+      // Plugin calls may alter the cache, so keep a copy while rendering.
+      const ParsedTemplateCache::ParsedTemplate copy = *parsed;
+      parseTemplate_render(newString, tmpString, copy, minimal_lineSize, useURLencode);
+    } else {
+      parseTemplate_render(newString, tmpString, *parsed, minimal_lineSize, useURLencode);
+    }
+  } else {
+    if (parseTemplate_CallBack_ptr != nullptr) {
+      parseTemplate_CallBack_ptr(tmpString, useURLencode);
+    }
+    parseSystemVariables(tmpString, useURLencode);
+
+
+    int startpos = 0;
+    int lastStartpos = 0;
+    int endpos = 0;
+    String deviceName, valueName, format;
+
+    while (findNextDevValNameInString(tmpString, startpos, endpos, deviceName, valueName, format)) {
+      // First copy all upto the start of the [...#...] part to be replaced.
+      newString += tmpString.substring(lastStartpos, startpos);
+
+      parseTemplate_placeholder(newString, deviceName, valueName, format, minimal_lineSize, tmpString);
+
+      // Conversion is done (or impossible) for the found "[...#...]"
+      // Continue with the next one.
+      lastStartpos = endpos + 1;
+      startpos     = endpos + 1;
+
+      // This may have taken some time, so call delay()
+      delay(0);
+    }
+
+    // Copy the rest of the string (or all if no replacements were done)
+    newString += tmpString.substring(lastStartpos);
+  }
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("parseTemplate2"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -174,7 +357,11 @@ String parseTemplate_padded(String& tmpString, byte minimal_lineSize, bool useUR
     newString += ' ';
   }
 
-  STOP_TIMER(PARSE_TEMPLATE_PADDED);
+  if (parsed != nullptr) {
+    STOP_TIMER(PARSE_TEMPLATE_CACHED);
+  } else {
+    STOP_TIMER(PARSE_TEMPLATE_PADDED);
+  }
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("parseTemplate3"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -26,6 +26,8 @@
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringProvider.h"
 
+#include <algorithm>
+
 
 
 String getReplacementString(const String& format, String& s) {
@@ -70,6 +72,160 @@ String timeReplacement_leadZero(int value)
 
 // FIXME TD-er: Try to match these with  StringProvider::getValue
 
+String SystemVariables::getReplacementValue(SystemVariables::Enum enumval)
+{
+  String value;
+
+  switch (enumval)
+  {
+    case BSSID:             value = String((WiFiEventData.WiFiDisconnected()) ? F("00:00:00:00:00:00") : WiFi.BSSIDstr()); break;
+    case CR:                value = "\r"; break;
+    case IP:                value = getValue(LabelType::IP_ADDRESS); break;
+    case IP4:               value = String( (int) NetworkLocalIP()[3] ); break; // 4th IP octet
+    case SUBNET:            value = getValue(LabelType::IP_SUBNET); break;
+    case DNS:               value = getValue(LabelType::DNS); break;
+    case GATEWAY:           value = getValue(LabelType::GATEWAY); break;
+    case CLIENTIP:          value = getValue(LabelType::CLIENT_IP); break;
+    #ifdef USES_MQTT
+    case ISMQTT:            value = String(MQTTclient_connected); break;
+    #else // ifdef USES_MQTT
+    case ISMQTT:            value = "0"; break;
+    #endif // ifdef USES_MQTT
+
+    #ifdef USES_P037
+    case ISMQTTIMP:         value = String(P037_MQTTImport_connected); break;
+    #else // ifdef USES_P037
+    case ISMQTTIMP:         value = "0"; break;
+    #endif // USES_P037
+
+
+    case ISNTP:             value = String(statusNTPInitialized ? 1 : 0); break;
+    case ISWIFI:            value = String(WiFiEventData.wifiStatus); break; // 0=disconnected, 1=connected, 2=got ip, 4=services initialized
+    // TODO: PKR: Add ETH Objects
+    #ifdef HAS_ETHERNET
+    
+    case ETHWIFIMODE:       value = getValue(LabelType::ETH_WIFI_MODE); break; // 0=WIFI, 1=ETH
+    case ETHCONNECTED:      value = getValue(LabelType::ETH_CONNECTED); break; // 0=disconnected, 1=connected
+    case ETHDUPLEX:         value = getValue(LabelType::ETH_DUPLEX); break;
+    case ETHSPEED:          value = getValue(LabelType::ETH_SPEED); break;
+    case ETHSTATE:          value = getValue(LabelType::ETH_STATE); break;
+    case ETHSPEEDSTATE:     value = getValue(LabelType::ETH_SPEED_STATE); break;
+    #endif
+    case LCLTIME:           value = getValue(LabelType::LOCAL_TIME); break;
+    case LCLTIME_AM:        value = node_time.getDateTimeString_ampm('-', ':', ' '); break;
+    case LF:                value = "\n"; break;
+    case MAC:               value = getValue(LabelType::STA_MAC); break;
+    case MAC_INT:           value = String(getChipId()); break; // Last 24 bit of MAC address as integer, to be used in rules.
+    case RSSI:              value = getValue(LabelType::WIFI_RSSI); break;
+    case SPACE:             value = " "; break;
+    case SSID:              value = (WiFiEventData.WiFiDisconnected()) ? F("--") : WiFi.SSID(); break;
+    case SUNRISE:
+    case SUNSET:
+      // Need the offset, see replSunRiseTimeString and replSunSetTimeString
+      break;
+    case SYSBUILD_DATE:     value = get_build_date(); break;
+    case SYSBUILD_DESCR:    value = getValue(LabelType::BUILD_DESC); break;
+    case SYSBUILD_FILENAME: value = getValue(LabelType::BINARY_FILENAME); break;
+    case SYSBUILD_GIT:      value = getValue(LabelType::GIT_BUILD); break;
+    case SYSBUILD_TIME:     value = get_build_time(); break;
+    case SYSDAY:            value = String(node_time.day()); break;
+    case SYSDAY_0:          value = timeReplacement_leadZero(node_time.day()); break;
+    case SYSHEAP:           value = String(ESP.getFreeHeap()); break;
+    case SYSHOUR:           value = String(node_time.hour()); break;
+    case SYSHOUR_0:         value = timeReplacement_leadZero(node_time.hour()); break;
+    case SYSLOAD:           value = String(getCPUload()); break;
+    case SYSMIN:            value = String(node_time.minute()); break;
+    case SYSMIN_0:          value = timeReplacement_leadZero(node_time.minute()); break;
+    case SYSMONTH:          value = String(node_time.month()); break;
+    case SYSNAME:           value = Settings.getHostname(); break;
+    case SYSSEC:            value = String(node_time.second()); break;
+    case SYSSEC_0:          value = timeReplacement_leadZero(node_time.second()); break;
+    case SYSSEC_D:          value = String(((node_time.hour() * 60) + node_time.minute()) * 60 + node_time.second()); break;
+    case SYSSTACK:          value = getValue(LabelType::FREE_STACK); break;
+    case SYSTIME:           value = node_time.getTimeString(':'); break;
+    case SYSTIME_AM:        value = node_time.getTimeString_ampm(':'); break;
+    case SYSTM_HM:          value = node_time.getTimeString(':', false); break;
+    case SYSTM_HM_AM:       value = node_time.getTimeString_ampm(':', false); break;
+    case SYSWEEKDAY:        value = String(node_time.weekday()); break;
+    case SYSWEEKDAY_S:      value = node_time.weekday_str(); break;
+    case SYSYEAR_0:
+    case SYSYEAR:           value = String(node_time.year()); break;
+    case SYSYEARS:          value = timeReplacement_leadZero(node_time.year() % 100); break;
+    case SYS_MONTH_0:       value = timeReplacement_leadZero(node_time.month()); break;
+    case S_CR:              value = F("\\r"); break;
+    case S_LF:              value = F("\\n"); break;
+    case UNIT_sysvar:       value = getValue(LabelType::UNIT_NR); break;
+    case UNIXDAY:           value = String(node_time.getUnixTime() / 86400); break;
+    case UNIXDAY_SEC:       value = String(node_time.getUnixTime() % 86400); break;
+    case UNIXTIME:          value = String(node_time.getUnixTime()); break;
+    case UPTIME:            value = String(wdcounter / 2); break;
+    #if FEATURE_ADC_VCC
+    case VCC:               value = String(vcc); break;
+    #else // if FEATURE_ADC_VCC
+    case VCC:               value = String(-1); break;
+    #endif // if FEATURE_ADC_VCC
+    case WI_CH:             value = String((WiFiEventData.WiFiDisconnected()) ? 0 : WiFi.channel()); break;
+
+    case UNKNOWN:
+      break;
+  }
+  return value;
+}
+
+#ifndef USE_LEGACY_SYSTEM_VARIABLES
+
+// Get the replacement for a %...% found in the string.
+// The token includes both '%' characters.
+// Return false when the token is not a system variable.
+static bool getSystemVariableTokenValue(const String& s, int startpos, int endpos, String& value)
+{
+  const char  *token       = s.c_str() + startpos;
+  const size_t tokenLength = endpos - startpos + 1;
+
+  const SystemVariables::Enum enumval = SystemVariables::fromToken(token, tokenLength);
+
+  switch (enumval) {
+    case SystemVariables::Enum::UNKNOWN:
+      break;
+    case SystemVariables::Enum::SUNRISE:
+    case SystemVariables::Enum::SUNSET:
+      // Only matched including an offset, handled below.
+      return false;
+    default:
+      value = SystemVariables::getReplacementValue(enumval);
+      return true;
+  }
+
+  if ((strncmp_P(token, PSTR("%sunrise"), 8) == 0) || (strncmp_P(token, PSTR("%sunset"), 7) == 0)) {
+    // e.g. %sunrise%, %sunset-1h%
+    const String R      = s.substring(startpos, endpos + 1);
+    const int    offset = ESPEasy_time::getSecOffset(R);
+
+    value = (token[4] == 'r') ?
+            node_time.getSunriseTimeString(':', offset) :
+            node_time.getSunsetTimeString(':', offset);
+    return true;
+  }
+
+  if ((tokenLength > 3) && (token[1] == 'v')) {
+    // %vN%  Custom variable N
+    unsigned int varNum = 0;
+
+    for (size_t i = 2; i < (tokenLength - 1); ++i) {
+      if (!isDigit(token[i])) {
+        return false;
+      }
+      varNum = varNum * 10 + (token[i] - '0');
+    }
+    const bool trimTrailingZeros = true;
+    value = doubleToString(getCustomFloatVar(varNum), 6, trimTrailingZeros);
+    return true;
+  }
+  return false;
+}
+
+#endif // ifndef USE_LEGACY_SYSTEM_VARIABLES
+
 void SystemVariables::parseSystemVariables(String& s, boolean useURLencode)
 {
   START_TIMER
@@ -79,115 +235,62 @@ void SystemVariables::parseSystemVariables(String& s, boolean useURLencode)
     return;
   }
 
+  #ifndef USE_LEGACY_SYSTEM_VARIABLES
+
+  // Scan the string once for %...% and append the replacements to a new string.
+  String result;
+  int    lastpos  = 0;
+  int    startpos = s.indexOf('%');
+
+  while (startpos != -1) {
+    const int endpos = s.indexOf('%', startpos + 1);
+
+    if (endpos == -1) {
+      break;
+    }
+    String value;
+
+    if (getSystemVariableTokenValue(s, startpos, endpos, value)) {
+      if (lastpos == 0) {
+        result.reserve(s.length() + value.length());
+      }
+      result += s.substring(lastpos, startpos);
+
+      if (useURLencode) {
+        result += URLEncode(value.c_str());
+      } else {
+        result += value;
+      }
+      lastpos  = endpos + 1;
+      startpos = s.indexOf('%', lastpos);
+    } else {
+      // The closing '%' may be the start of the next system variable.
+      startpos = endpos;
+    }
+  }
+
+  if (lastpos != 0) {
+    result += s.substring(lastpos);
+    std::swap(s, result);
+  }
+  #else // ifndef USE_LEGACY_SYSTEM_VARIABLES
+
   SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(0);
 
   do {
     enumval = SystemVariables::nextReplacementEnum(s, enumval);
-    String value;
 
     switch (enumval)
     {
-      case BSSID:             value = String((WiFiEventData.WiFiDisconnected()) ? F("00:00:00:00:00:00") : WiFi.BSSIDstr()); break;
-      case CR:                value = "\r"; break;
-      case IP:                value = getValue(LabelType::IP_ADDRESS); break;
-      case IP4:               value = String( (int) NetworkLocalIP()[3] ); break; // 4th IP octet
-      case SUBNET:            value = getValue(LabelType::IP_SUBNET); break;
-      case DNS:               value = getValue(LabelType::DNS); break;
-      case GATEWAY:           value = getValue(LabelType::GATEWAY); break;
-      case CLIENTIP:          value = getValue(LabelType::CLIENT_IP); break;
-      #ifdef USES_MQTT
-      case ISMQTT:            value = String(MQTTclient_connected); break;
-      #else // ifdef USES_MQTT
-      case ISMQTT:            value = "0"; break;
-      #endif // ifdef USES_MQTT
-
-      #ifdef USES_P037
-      case ISMQTTIMP:         value = String(P037_MQTTImport_connected); break;
-      #else // ifdef USES_P037
-      case ISMQTTIMP:         value = "0"; break;
-      #endif // USES_P037
-
-
-      case ISNTP:             value = String(statusNTPInitialized ? 1 : 0); break;
-      case ISWIFI:            value = String(WiFiEventData.wifiStatus); break; // 0=disconnected, 1=connected, 2=got ip, 4=services initialized
-      // TODO: PKR: Add ETH Objects
-      #ifdef HAS_ETHERNET
-      
-      case ETHWIFIMODE:       value = getValue(LabelType::ETH_WIFI_MODE); break; // 0=WIFI, 1=ETH
-      case ETHCONNECTED:      value = getValue(LabelType::ETH_CONNECTED); break; // 0=disconnected, 1=connected
-      case ETHDUPLEX:         value = getValue(LabelType::ETH_DUPLEX); break;
-      case ETHSPEED:          value = getValue(LabelType::ETH_SPEED); break;
-      case ETHSTATE:          value = getValue(LabelType::ETH_STATE); break;
-      case ETHSPEEDSTATE:     value = getValue(LabelType::ETH_SPEED_STATE); break;
-      #endif
-      case LCLTIME:           value = getValue(LabelType::LOCAL_TIME); break;
-      case LCLTIME_AM:        value = node_time.getDateTimeString_ampm('-', ':', ' '); break;
-      case LF:                value = "\n"; break;
-      case MAC:               value = getValue(LabelType::STA_MAC); break;
-      case MAC_INT:           value = String(getChipId()); break; // Last 24 bit of MAC address as integer, to be used in rules.
-      case RSSI:              value = getValue(LabelType::WIFI_RSSI); break;
-      case SPACE:             value = " "; break;
-      case SSID:              value = (WiFiEventData.WiFiDisconnected()) ? F("--") : WiFi.SSID(); break;
       case SUNRISE:           SMART_REPL_T(SystemVariables::toString(enumval), replSunRiseTimeString); break;
       case SUNSET:            SMART_REPL_T(SystemVariables::toString(enumval), replSunSetTimeString); break;
-      case SYSBUILD_DATE:     value = get_build_date(); break;
-      case SYSBUILD_DESCR:    value = getValue(LabelType::BUILD_DESC); break;
-      case SYSBUILD_FILENAME: value = getValue(LabelType::BINARY_FILENAME); break;
-      case SYSBUILD_GIT:      value = getValue(LabelType::GIT_BUILD); break;
-      case SYSBUILD_TIME:     value = get_build_time(); break;
-      case SYSDAY:            value = String(node_time.day()); break;
-      case SYSDAY_0:          value = timeReplacement_leadZero(node_time.day()); break;
-      case SYSHEAP:           value = String(ESP.getFreeHeap()); break;
-      case SYSHOUR:           value = String(node_time.hour()); break;
-      case SYSHOUR_0:         value = timeReplacement_leadZero(node_time.hour()); break;
-      case SYSLOAD:           value = String(getCPUload()); break;
-      case SYSMIN:            value = String(node_time.minute()); break;
-      case SYSMIN_0:          value = timeReplacement_leadZero(node_time.minute()); break;
-      case SYSMONTH:          value = String(node_time.month()); break;
-      case SYSNAME:           value = Settings.getHostname(); break;
-      case SYSSEC:            value = String(node_time.second()); break;
-      case SYSSEC_0:          value = timeReplacement_leadZero(node_time.second()); break;
-      case SYSSEC_D:          value = String(((node_time.hour() * 60) + node_time.minute()) * 60 + node_time.second()); break;
-      case SYSSTACK:          value = getValue(LabelType::FREE_STACK); break;
-      case SYSTIME:           value = node_time.getTimeString(':'); break;
-      case SYSTIME_AM:        value = node_time.getTimeString_ampm(':'); break;
-      case SYSTM_HM:          value = node_time.getTimeString(':', false); break;
-      case SYSTM_HM_AM:       value = node_time.getTimeString_ampm(':', false); break;
-      case SYSWEEKDAY:        value = String(node_time.weekday()); break;
-      case SYSWEEKDAY_S:      value = node_time.weekday_str(); break;
-      case SYSYEAR_0:
-      case SYSYEAR:           value = String(node_time.year()); break;
-      case SYSYEARS:          value = timeReplacement_leadZero(node_time.year() % 100); break;
-      case SYS_MONTH_0:       value = timeReplacement_leadZero(node_time.month()); break;
-      case S_CR:              value = F("\\r"); break;
-      case S_LF:              value = F("\\n"); break;
-      case UNIT_sysvar:       value = getValue(LabelType::UNIT_NR); break;
-      case UNIXDAY:           value = String(node_time.getUnixTime() / 86400); break;
-      case UNIXDAY_SEC:       value = String(node_time.getUnixTime() % 86400); break;
-      case UNIXTIME:          value = String(node_time.getUnixTime()); break;
-      case UPTIME:            value = String(wdcounter / 2); break;
-      #if FEATURE_ADC_VCC
-      case VCC:               value = String(vcc); break;
-      #else // if FEATURE_ADC_VCC
-      case VCC:               value = String(-1); break;
-      #endif // if FEATURE_ADC_VCC
-      case WI_CH:             value = String((WiFiEventData.WiFiDisconnected()) ? 0 : WiFi.channel()); break;
-
-      case UNKNOWN:
-        break;
-    }
-
-    switch (enumval)
-    {
-      case SUNRISE:
-      case SUNSET:
       case UNKNOWN:
 
         // Do not replace
         break;
       default:
 
-        repl(SystemVariables::toString(enumval), value, s, useURLencode);
+        repl(SystemVariables::toString(enumval), getReplacementValue(enumval), s, useURLencode);
         break;
     }
   }
@@ -206,6 +309,7 @@ void SystemVariables::parseSystemVariables(String& s, boolean useURLencode)
       }
     }
   }
+  #endif // ifndef USE_LEGACY_SYSTEM_VARIABLES
 
   STOP_TIMER(PARSE_SYSVAR);
 }
@@ -253,7 +357,57 @@ SystemVariables::Enum SystemVariables::nextReplacementEnum(const String& str, Sy
   return Enum::UNKNOWN;
 }
 
+SystemVariables::Enum SystemVariables::fromToken(const char *token, size_t length)
+{
+  // Enum values sorted on their name, to allow a binary search.
+  static uint8_t sortedEnums[Enum::UNKNOWN];
+  static bool    sorted = false;
+
+  if (!sorted) {
+    for (int i = 0; i < Enum::UNKNOWN; ++i) {
+      sortedEnums[i] = i;
+    }
+    std::sort(sortedEnums, sortedEnums + Enum::UNKNOWN, [](uint8_t a, uint8_t b) {
+      char name_a[32] = { 0 };
+      strncpy_P(name_a, (PGM_P)toFlashString(static_cast<Enum>(a)), sizeof(name_a) - 1);
+      return strcmp_P(name_a, (PGM_P)toFlashString(static_cast<Enum>(b))) < 0;
+    });
+    sorted = true;
+  }
+
+  int first = 0;
+  int last  = Enum::UNKNOWN - 1;
+
+  while (first <= last) {
+    const int  middle  = (first + last) / 2;
+    const Enum enumval = static_cast<Enum>(sortedEnums[middle]);
+    PGM_P      name    = (PGM_P)toFlashString(enumval);
+    int res            = strncmp_P(token, name, length);
+
+    if ((res == 0) && (strlen_P(name) > length)) {
+      // Token matches only the first part of the name
+      res = -1;
+    }
+
+    if (res == 0) {
+      return enumval;
+    }
+
+    if (res < 0) {
+      last = middle - 1;
+    } else {
+      first = middle + 1;
+    }
+  }
+  return Enum::UNKNOWN;
+}
+
 String SystemVariables::toString(SystemVariables::Enum enumval)
+{
+  return toFlashString(enumval);
+}
+
+const __FlashStringHelper * SystemVariables::toFlashString(SystemVariables::Enum enumval)
 {
   switch (enumval) {
     case Enum::BSSID:           return F("%bssid%");
@@ -90,8 +90,22 @@ public:
 
   static String toString(Enum enumval);
 
+  // Find the system variable matching the token, e.g. "%sysname%"
+  // Return UNKNOWN when not found.
+  static Enum fromToken(const char *token, size_t length);
+
+  // Current value of the system variable.
+  // SUNRISE and SUNSET need an offset and thus are not handled here.
+  static String getReplacementValue(Enum enumval);
+
+  // Replace all system variables in the string.
+  // Define USE_LEGACY_SYSTEM_VARIABLES to search for each known variable separately
+  // instead of scanning the string once.
   static void parseSystemVariables(String& s, boolean useURLencode);
 
+private:
+
+  static const __FlashStringHelper * toFlashString(Enum enumval);
 
 
 };
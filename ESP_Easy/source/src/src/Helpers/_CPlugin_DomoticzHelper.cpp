@@ -7,13 +7,17 @@
 
 #include "../ESPEasyCore/ESPEasy_Log.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/ExtraTaskSettings.h"
+#include "../Globals/Settings.h"
 
 #include "../Helpers/Convert.h"
 #include "../Helpers/StringConverter.h"
 
 #include "../../ESPEasy-Globals.h"
 
+#include <algorithm>
+
 
 
 // HUM_STAT can be one of:
@@ -196,4 +200,229 @@ String formatDomoticzSensorType(struct EventStruct *event) {
   }
   return values;
 }
+# ifdef USES_C002
+
+unsigned long domoticzIdxFilterHandled = 0;
+unsigned long domoticzIdxFilterDropped = 0;
+
+bool findDomoticzIdx(const byte *payload, unsigned int length, unsigned int& idx) {
+  if (payload == nullptr) {
+    return false;
+  }
+
+  for (unsigned int pos = 0; (pos + 5) < length; ++pos) {
+    // Look for "idx" as key, not escaped inside some string value.
+    if ((payload[pos] != '"') ||
+        (payload[pos + 1] != 'i') ||
+        (payload[pos + 2] != 'd') ||
+        (payload[pos + 3] != 'x') ||
+        (payload[pos + 4] != '"') ||
+        ((pos > 0) && (payload[pos - 1] == '\\'))) {
+      continue;
+    }
+    unsigned int valuePos = pos + 5;
+
+    while (valuePos < length && isspace(payload[valuePos])) { ++valuePos; }
+
+    if ((valuePos >= length) || (payload[valuePos] != ':')) {
+      continue;
+    }
+    ++valuePos;
+
+    while (valuePos < length && isspace(payload[valuePos])) { ++valuePos; }
+
+    if ((valuePos < length) && (payload[valuePos] == '"')) {
+      ++valuePos;
+    }
+
+    unsigned int value    = 0;
+    unsigned int nrDigits = 0;
+
+    while (valuePos < length && isdigit(payload[valuePos]) && nrDigits < 10) {
+      value = value * 10 + (payload[valuePos] - '0');
+      ++valuePos;
+      ++nrDigits;
+    }
+
+    if (nrDigits > 0) {
+      idx = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Collect the idx values of the tasks which act upon a received Domoticz message.
+// Must match the plugins handled in CPLUGIN_PROTOCOL_RECV of C002.
+static void updateDomoticzIdxCache(controllerIndex_t ControllerIndex) {
+  Cache.domoticzIdx.clear();
+
+  if (validControllerIndex(ControllerIndex)) {
+    for (taskIndex_t x = 0; x < TASKS_MAX; x++) {
+      if (Settings.TaskDeviceEnabled[x]) {
+        switch (Settings.TaskDeviceNumber[x]) {
+          case 1:   // Switch input
+          case 29:  // Domoticz MQTT Helper
+          case 88:  // Heatpump IR
+          case 115: // Heatpump IR
+          {
+            const unsigned int idx = Settings.TaskDeviceID[ControllerIndex][x];
+
+            // idx 0 is not a valid Domoticz idx
+            if ((idx != 0) &&
+                !std::binary_search(Cache.domoticzIdx.begin(), Cache.domoticzIdx.end(), idx)) {
+              Cache.domoticzIdx.insert(
+                std::upper_bound(Cache.domoticzIdx.begin(), Cache.domoticzIdx.end(), idx),
+                idx);
+            }
+            break;
+          }
+          default:
+            break;
+        }
+      }
+    }
+  }
+  Cache.domoticzIdxControllerIndex = ControllerIndex;
+  Cache.domoticzIdxValid           = true;
+}
+
+bool acceptDomoticzMessage(controllerIndex_t ControllerIndex, const byte *payload, unsigned int length) {
+  if (!Cache.domoticzIdxValid || (Cache.domoticzIdxControllerIndex != ControllerIndex)) {
+    updateDomoticzIdxCache(ControllerIndex);
+  }
+
+  unsigned int idx = 0;
+
+  if (findDomoticzIdx(payload, length, idx) &&
+      std::binary_search(Cache.domoticzIdx.begin(), Cache.domoticzIdx.end(), idx)) {
+    ++domoticzIdxFilterHandled;
+    return true;
+  }
+  ++domoticzIdxFilterDropped;
+  return false;
+}
+
+String getDomoticzIdxFilterStats() {
+  String res;
+
+  res.reserve(48);
+  res += F("handled: ");
+  res += domoticzIdxFilterHandled;
+  res += F(" dropped: ");
+  res += domoticzIdxFilterDropped;
+  return res;
+}
+
+static const DomoticzPayloadTemplate& getDomoticzPayloadTemplate(struct EventStruct *event) {
+  auto it = Cache.domoticzPayloadTemplate.find(event->TaskIndex);
+
+  if ((it != Cache.domoticzPayloadTemplate.end()) && (it->second.idx == static_cast<unsigned int>(event->idx))) {
+    return it->second;
+  }
+
+  DomoticzPayloadTemplate& payloadTemplate = Cache.domoticzPayloadTemplate[event->TaskIndex];
+
+  payloadTemplate.idx        = event->idx;
+  payloadTemplate.sensorType = event->getSensorType();
+  payloadTemplate.prefix     = F("{\"idx\":");
+  payloadTemplate.prefix    += event->idx;
+  payloadTemplate.prefix    += F(",\"RSSI\":");
+
+  switch (payloadTemplate.sensorType) {
+    case Sensor_VType::SENSOR_TYPE_SWITCH:
+    case Sensor_VType::SENSOR_TYPE_DIMMER:
+      payloadTemplate.valuePrefix = F(",\"command\":\"switchlight\",");
+      break;
+    default:
+      payloadTemplate.valuePrefix = F(",\"nvalue\":0,\"svalue\":\"");
+      break;
+  }
+  return payloadTemplate;
+}
+
+// Append the value as JSON string content, escaping quotes, backslashes and control characters.
+static void appendJsonEscaped(String& payload, const String& value) {
+  const unsigned int length = value.length();
+
+  for (unsigned int i = 0; i < length; ++i) {
+    const char c = value[i];
+
+    if ((c == '"') || (c == '\\')) {
+      payload += '\\';
+      payload += c;
+    } else if (static_cast<uint8_t>(c) < 0x20) {
+      payload += '\\';
+
+      switch (c) {
+        case '\b': payload += 'b'; break;
+        case '\f': payload += 'f'; break;
+        case '\n': payload += 'n'; break;
+        case '\r': payload += 'r'; break;
+        case '\t': payload += 't'; break;
+        default:
+        {
+          static const char hexDigits[] = "0123456789abcdef";
+          payload += F("u00");
+          payload += hexDigits[(c >> 4) & 0x0F];
+          payload += hexDigits[c & 0x0F];
+          break;
+        }
+      }
+    } else {
+      payload += c;
+    }
+  }
+}
+
+void formatDomoticzMQTTpayload(struct EventStruct *event, String& payload) {
+  const DomoticzPayloadTemplate& payloadTemplate = getDomoticzPayloadTemplate(event);
+
+  String values;
+
+  if ((payloadTemplate.sensorType != Sensor_VType::SENSOR_TYPE_SWITCH) &&
+      (payloadTemplate.sensorType != Sensor_VType::SENSOR_TYPE_DIMMER)) {
+    values = formatDomoticzSensorType(event);
+  }
+
+  // Allocate once, with some room for the RSSI, battery and switch state.
+  payload.reserve(payloadTemplate.prefix.length() + payloadTemplate.valuePrefix.length() + values.length() + 40);
+  payload += payloadTemplate.prefix;
+  payload += mapRSSItoDomoticz();
+  # if FEATURE_ADC_VCC
+  payload += F(",\"Battery\":");
+  payload += mapVccToDomoticz();
+  # endif // if FEATURE_ADC_VCC
+  payload += payloadTemplate.valuePrefix;
+
+  const float value = UserVar[event->BaseVarIndex];
+
+  switch (payloadTemplate.sensorType) {
+    case Sensor_VType::SENSOR_TYPE_SWITCH:
+      payload += (value == 0) ? F("\"switchcmd\":\"Off\"}") : F("\"switchcmd\":\"On\"}");
+      break;
+    case Sensor_VType::SENSOR_TYPE_DIMMER:
+
+      if (value == 0) {
+        payload += F("\"switchcmd\":\"Off\"}");
+      } else {
+        payload += F("\"Set%20Level\":");
+
+        if (value == static_cast<int>(value)) {
+          payload += static_cast<int>(value);
+        } else {
+          payload += toString(value, 2);
+        }
+        payload += '}';
+      }
+      break;
+    default:
+      appendJsonEscaped(payload, values);
+      payload += F("\"}");
+      break;
+  }
+}
+
+# endif // ifdef USES_C002
+
 #endif // USES_DOMOTICZ
@@ -27,6 +27,33 @@ String formatUserVarDomoticz(struct EventStruct *event,
 String formatUserVarDomoticz(int value);
 
 String formatDomoticzSensorType(struct EventStruct *event);
+
+# ifdef USES_C002
+
+/*********************************************************************************************\
+* Prefilter for messages received from Domoticz (domoticz/out)
+* Domoticz publishes every device change, so most messages are meant for other nodes.
+* The "idx" value is looked up in the payload without parsing the JSON and checked
+* against the idx values of the tasks which may handle the message.
+\*********************************************************************************************/
+
+// Find the value of the "idx" key in the (not zero terminated) JSON payload.
+bool   findDomoticzIdx(const byte   *payload,
+                       unsigned int  length,
+                       unsigned int& idx);
+
+// Return true when the message may be handled by one of the tasks.
+bool   acceptDomoticzMessage(controllerIndex_t ControllerIndex,
+                             const byte       *payload,
+                             unsigned int      length);
+
+String getDomoticzIdxFilterStats();
+
+// Format the JSON payload sent to Domoticz MQTT (domoticz/in).
+// The constant parts are rendered once per task and kept in the cache.
+void   formatDomoticzMQTTpayload(struct EventStruct *event,
+                                 String            & payload);
+# endif // ifdef USES_C002
 #endif // USES_DOMOTICZ
 
 
@@ -45,6 +45,8 @@ String getControllerParameterName(protocolIndex_t                   ProtocolInde
     case ControllerSettingsStruct::CONTROLLER_MAX_RETRIES:              name = F("Max Retries");            break;
     case ControllerSettingsStruct::CONTROLLER_FULL_QUEUE_ACTION:        name = F("Full Queue Action");      break;
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:              name = F("Check Reply");            break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_SIZE:               name = F("Batch Size");             break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_FLUSH_INTERVAL:     name = F("Batch Flush Interval");   break;
 
     case ControllerSettingsStruct::CONTROLLER_CLIENT_ID:                name = F("Controller Client ID");   break;
     case ControllerSettingsStruct::CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT: name = F("Unique Client ID on Reconnect");   break;
@@ -200,6 +202,19 @@ void addControllerParameterForm(const ControllerSettingsStruct& ControllerSettin
       addFormSelector(displayName, internalName, 2, options, NULL, NULL, ControllerSettings.MustCheckReply, false);
       break;
     }
+    case ControllerSettingsStruct::CONTROLLER_BATCH_SIZE:
+    {
+      addFormNumericBox(displayName, internalName, ControllerSettings.BatchSize, 0, CONTROLLER_DELAY_QUEUE_BATCH_MAX);
+      addFormNote(F("Max. number of queued messages sent at once. 0 or 1: No batching"));
+      break;
+    }
+    case ControllerSettingsStruct::CONTROLLER_BATCH_FLUSH_INTERVAL:
+    {
+      addFormNumericBox(displayName, internalName, ControllerSettings.BatchFlushInterval, 0, CONTROLLER_DELAY_QUEUE_FLUSH_MAX);
+      addUnit(F("ms"));
+      addFormNote(F("Max. time to wait for a batch to fill up. 0: Send immediately"));
+      break;
+    }
     case ControllerSettingsStruct::CONTROLLER_CLIENT_ID:
       addFormTextBox(displayName, internalName, ControllerSettings.ClientID, sizeof(ControllerSettings.ClientID) - 1);
       break;
@@ -316,6 +331,14 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_CHECK_REPLY:
       ControllerSettings.MustCheckReply = getFormItemInt(internalName, ControllerSettings.MustCheckReply);
       break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_SIZE:
+      ControllerSettings.BatchSize = getFormItemInt(internalName, ControllerSettings.BatchSize);
+      ControllerSettings.batchSettingsSet(true);
+      break;
+    case ControllerSettingsStruct::CONTROLLER_BATCH_FLUSH_INTERVAL:
+      ControllerSettings.BatchFlushInterval = getFormItemInt(internalName, ControllerSettings.BatchFlushInterval);
+      ControllerSettings.batchSettingsSet(true);
+      break;
 
     case ControllerSettingsStruct::CONTROLLER_CLIENT_ID:
       strncpy_webserver_arg(ControllerSettings.ClientID, internalName);
@@ -6,9 +6,11 @@
 
 
 #define MAX_SCHEDULER_WAIT_TIME 5 // Max delay used in the scheduler for passing idle time.
+#define MIN_TIMER_HEAP_CAPACITY 32 // Initial number of timers allocated at once.
 
   msecTimerHandlerStruct::msecTimerHandlerStruct() : get_called(0), get_called_ret_id(0), max_queue_length(0),
-    last_exec_time_usec(0), total_idle_time_usec(0),  idle_time_pct(0.0f), is_idle(false), eco_mode(true)
+    last_exec_time_usec(0), total_idle_time_usec(0),  idle_time_pct(0.0f), is_idle(false), eco_mode(true),
+    _id_index_bits(0)
   {
     last_log_start_time = millis();
   }
@@ -36,7 +38,7 @@
       }
       return 0;
     }
-    timer_id_couple item = _timer_ids.front();
+    const timer_id_couple item = _timer_ids.front();
     const long passed    = timePassedSince(item._timer);
 
     if (passed < 0) {
@@ -60,7 +62,7 @@
     unsigned long size = _timer_ids.size();
 
     if (size > max_queue_length) { max_queue_length = size; }
-    _timer_ids.pop_front();
+    removeAt(0);
     timer = item._timer;
     ++get_called_ret_id;
     return item._id;
@@ -68,13 +70,13 @@
 
 
   bool msecTimerHandlerStruct::getTimerForId(unsigned long id, unsigned long& timer) const {
-    for (auto it = _timer_ids.begin(); it != _timer_ids.end(); ++it) {
-      if (it->_id == id) {
-        timer = it->_timer;
-        return true;
-      }
+    const int pos = findIndexPos(id);
+
+    if (pos < 0) {
+      return false;
     }
-    return false;
+    timer = _timer_ids[_id_index[pos] - 1]._timer;
+    return true;
   }
 
   String msecTimerHandlerStruct::getQueueStats() {
@@ -106,31 +108,163 @@
     return idle_time_pct;
   }
 
-  struct match_id {
-    match_id(unsigned long id) : _id(id) {}
+  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+    if (item._id == 0) { return; }
+
+    // Make sure only one is present with the same id.
+    const int pos = findIndexPos(item._id);
+
+    if (pos >= 0) {
+      // Already scheduled, only need to move it to its new position in the heap.
+      const size_t slot = _id_index[pos] - 1;
+      _timer_ids[slot]._timer = item._timer;
+      siftUp(slot);
+      siftDown(slot);
+      return;
+    }
 
-    bool operator()(const timer_id_couple& item) {
-      return _id == item._id;
+    if (((_timer_ids.size() + 1) * 2) > _id_index.size()) {
+      growIndex();
     }
+    _timer_ids.push_back(item);
+    indexInsert(item._id, _timer_ids.size() - 1);
+    siftUp(_timer_ids.size() - 1);
+  }
 
-    unsigned long _id;
-  };
+  bool msecTimerHandlerStruct::isEarlier(size_t slotA, size_t slotB) const {
+    // timediff > 0, means timer A is set before timer B
+    return timeDiff(_timer_ids[slotA]._timer, _timer_ids[slotB]._timer) > 0;
+  }
 
-  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+  void msecTimerHandlerStruct::swapSlots(size_t slotA, size_t slotB) {
+    const int posA = findIndexPos(_timer_ids[slotA]._id);
+    const int posB = findIndexPos(_timer_ids[slotB]._id);
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
-    const bool mustSort = !_timer_ids.empty();
-    _timer_ids.push_front(item);
+    std::swap(_timer_ids[slotA], _timer_ids[slotB]);
+    _id_index[posA] = slotB + 1;
+    _id_index[posB] = slotA + 1;
+  }
+
+  void msecTimerHandlerStruct::siftUp(size_t slot) {
+    while (slot > 0) {
+      const size_t parent = (slot - 1) / 2;
 
-    if (mustSort) {
-      _timer_ids.sort(); // TD-er: Must check if this is an expensive operation.
+      if (!isEarlier(slot, parent)) {
+        return;
+      }
+      swapSlots(slot, parent);
+      slot = parent;
+    }
+  }
+
+  void msecTimerHandlerStruct::siftDown(size_t slot) {
+    const size_t size = _timer_ids.size();
+
+    while (true) {
+      const size_t left  = 2 * slot + 1;
+      const size_t right = left + 1;
+      size_t earliest    = slot;
+
+      if ((left < size) && isEarlier(left, earliest)) {
+        earliest = left;
+      }
+
+      if ((right < size) && isEarlier(right, earliest)) {
+        earliest = right;
+      }
+
+      if (earliest == slot) {
+        return;
+      }
+      swapSlots(slot, earliest);
+      slot = earliest;
     }
+  }
+
+  void msecTimerHandlerStruct::removeAt(size_t slot) {
+    const int pos = findIndexPos(_timer_ids[slot]._id);
 
-    // It should be a relative light operation, to insert into a sorted list.
-    // Perhaps it is better to use std::set ????
-    // Keep in mind: order is based on timer, uniqueness is based on id.
+    if (pos >= 0) {
+      indexErase(pos);
+    }
+    const size_t last = _timer_ids.size() - 1;
+
+    if (slot != last) {
+      // Move the last item into the freed slot and restore the heap order.
+      const int lastPos = findIndexPos(_timer_ids[last]._id);
+      _timer_ids[slot]   = _timer_ids[last];
+      _id_index[lastPos] = slot + 1;
+      _timer_ids.pop_back();
+      siftUp(slot);
+      siftDown(slot);
+    } else {
+      _timer_ids.pop_back();
+    }
+  }
+
+  size_t msecTimerHandlerStruct::getIndexHome(unsigned long id) const {
+    // Fibonacci hashing, the mixed ids differ mainly in their lower bits.
+    return static_cast<uint32_t>(id * 2654435769UL) >> (32 - _id_index_bits);
+  }
+
+  int msecTimerHandlerStruct::findIndexPos(unsigned long id) const {
+    if (_id_index.empty()) {
+      return -1;
+    }
+    const size_t mask = _id_index.size() - 1;
+
+    for (size_t pos = getIndexHome(id); _id_index[pos] != 0; pos = (pos + 1) & mask) {
+      if (_timer_ids[_id_index[pos] - 1]._id == id) {
+        return pos;
+      }
+    }
+    return -1;
+  }
+
+  void msecTimerHandlerStruct::indexInsert(unsigned long id, size_t slot) {
+    const size_t mask = _id_index.size() - 1;
+    size_t pos        = getIndexHome(id);
+
+    while (_id_index[pos] != 0) {
+      pos = (pos + 1) & mask;
+    }
+    _id_index[pos] = slot + 1;
+  }
+
+  void msecTimerHandlerStruct::indexErase(size_t pos) {
+    // Shift back the following entries of the probe sequence, so no tombstones are needed.
+    const size_t mask = _id_index.size() - 1;
+    size_t hole       = pos;
+    size_t next       = (pos + 1) & mask;
+
+    while (_id_index[next] != 0) {
+      const size_t home = getIndexHome(_timer_ids[_id_index[next] - 1]._id);
+
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        _id_index[hole] = _id_index[next];
+        hole            = next;
+      }
+      next = (next + 1) & mask;
+    }
+    _id_index[hole] = 0;
+  }
+
+  void msecTimerHandlerStruct::growIndex() {
+    const size_t capacity = _timer_ids.empty() ? MIN_TIMER_HEAP_CAPACITY : _timer_ids.size() * 2;
+
+    _timer_ids.reserve(capacity);
+
+    uint8_t bits = 1;
+
+    while ((1u << bits) < (capacity * 2)) {
+      ++bits;
+    }
+    _id_index_bits = bits;
+    _id_index.assign(1u << bits, 0);
+
+    for (size_t slot = 0; slot < _timer_ids.size(); ++slot) {
+      indexInsert(_timer_ids[slot]._id, slot);
+    }
   }
 
   void msecTimerHandlerStruct::recordIdle() {
@@ -3,7 +3,7 @@
 
 
 #include <Arduino.h>
-#include <list>
+#include <vector>
 
 #include "../DataStructs/timer_id_couple.h"
 
@@ -39,6 +39,32 @@ private:
 
   void recordRunning();
 
+  // Binary heap operations, the first timer to expire is kept at slot 0.
+  bool isEarlier(size_t slotA,
+                 size_t slotB) const;
+
+  void swapSlots(size_t slotA,
+                 size_t slotB);
+
+  void siftUp(size_t slot);
+
+  void siftDown(size_t slot);
+
+  void removeAt(size_t slot);
+
+  // Index from id to heap slot.
+  // Open addressing with linear probing, 0 marks an empty position.
+  size_t getIndexHome(unsigned long id) const;
+
+  int    findIndexPos(unsigned long id) const;
+
+  void   indexInsert(unsigned long id,
+                     size_t        slot);
+
+  void   indexErase(size_t pos);
+
+  void   growIndex();
+
   // Statistics
   unsigned long get_called;
   unsigned long get_called_ret_id;
@@ -52,8 +78,14 @@ private:
   bool          is_idle;
   bool          eco_mode;
 
-  // The list of set timers
-  std::list<timer_id_couple>_timer_ids;
+  // The set timers, stored as binary heap ordered on timer.
+  // Capacity is only increased when more timers are set than ever before,
+  // so normal scheduling does not allocate memory.
+  std::vector<timer_id_couple>_timer_ids;
+
+  // Heap slot + 1 per id, size is always a power of 2 and at least twice the heap capacity.
+  std::vector<uint16_t>_id_index;
+  uint8_t              _id_index_bits;
 };
 
 #endif // HELPERS_MSECTIMERHANDLERSTRUCT_H
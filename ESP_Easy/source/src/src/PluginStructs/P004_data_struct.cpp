@@ -11,6 +11,11 @@ P004_data_struct::P004_data_struct(int8_t pin_rx, int8_t pin_tx, const uint8_t a
   set_measurement_inactive();
 }
 
+P004_data_struct::~P004_data_struct()
+{
+  Dallas_unregisterBusSensors(_gpio_rx, this);
+}
+
 void P004_data_struct::add_addr(const uint8_t addr[], uint8_t index) {
   if (index < 4) {
     _sensors[index].addr = Dallas_addr_to_uint64(addr);
@@ -23,34 +28,48 @@ void P004_data_struct::add_addr(const uint8_t addr[], uint8_t index) {
         }
       }
     }
-    _sensors[index].check_sensor(_gpio_rx, _gpio_tx, _res);
+    if (_sensors[index].check_sensor(_gpio_rx, _gpio_tx, _res)) {
+      Dallas_registerBusSensor(_gpio_rx, this, _res, _sensors[index].parasitePowered);
+    }
   }
 }
 
 bool P004_data_struct::initiate_read() {
   _measurementStart = millis();
 
-  for (byte i = 0; i < 4; ++i) {
-    if (_sensors[i].initiate_read(_gpio_rx, _gpio_tx, _res)) {
-      if (!measurement_active()) {
-        // Set the timer right after initiating the first sensor
-
-
-        /*********************************************************************************************\
-        *  Dallas Start Temperature Conversion, expected max duration:
-        *    9 bits resolution ->  93.75 ms
-        *   10 bits resolution -> 187.5 ms
-        *   11 bits resolution -> 375 ms
-        *   12 bits resolution -> 750 ms
-        \*********************************************************************************************/
-        uint8_t res = _res;
-
-        if ((res < 9) || (res > 12)) { res = 12; }
-        _timer = millis() + (800 / (1 << (12 - res)));
+  if (!Dallas_busConversionActive(_gpio_rx)) {
+    // Retry sensors which failed before, while no conversion is running on the bus.
+    for (byte i = 0; i < 4; ++i) {
+      if ((_sensors[i].addr != 0) && _sensors[i].lastReadError) {
+        if (_sensors[i].check_sensor(_gpio_rx, _gpio_tx, _res)) {
+          _sensors[i].lastReadError = false;
+          Dallas_registerBusSensor(_gpio_rx, this, _res, _sensors[i].parasitePowered);
+        }
       }
+    }
+  }
+
+  // Start the conversion on all sensors on the bus at once,
+  // or join the conversion started by another task using the same GPIO pin.
+  bool joined               = false;
+  const unsigned long ready = Dallas_startBusConversion(_gpio_rx, _gpio_tx, joined);
+
+  if (ready == 0) {
+    for (byte i = 0; i < 4; ++i) {
+      if (_sensors[i].addr != 0) {
+        ++_sensors[i].read_failed;
+        _sensors[i].lastReadError = true;
+      }
+    }
+    return false;
+  }
+
+  for (byte i = 0; i < 4; ++i) {
+    if ((_sensors[i].addr != 0) && (joined || !_sensors[i].lastReadError)) {
       _sensors[i].measurementActive = true;
     }
   }
+  _timer = ready;
 
   return measurement_active();
 }
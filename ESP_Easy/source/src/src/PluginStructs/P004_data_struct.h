@@ -33,14 +33,16 @@ struct P004_data_struct : public PluginTaskData_base {
                    const uint8_t addr[],
                    uint8_t       res);
 
+  virtual ~P004_data_struct();
+
   // Add extra sensor address
   // @param addr The address to add
   // @param index  The index (0...3) to store this address
   void add_addr(const uint8_t addr[],
                 uint8_t       index);
 
-  // Send the start measuremnt command to all set sensors which have a non-zero address
-  // Their index determines the order in which the sensors receive this command.
+  // Start the measurement on all sensors on the bus with a single Skip-ROM command,
+  // or join the measurement already started by another task using the same GPIO pin.
   bool initiate_read();
 
   bool collect_values();
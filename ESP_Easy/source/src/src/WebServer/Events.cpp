@@ -0,0 +1,216 @@
+#include "../WebServer/Events.h"
+
+#ifdef WEBSERVER_EVENTS
+
+# include "../WebServer/WebServer.h"
+
+# include "../CustomBuild/ESPEasyLimits.h"
+
+# include "../Globals/Device.h"
+# include "../Globals/Plugins.h"
+
+# include "../Helpers/ESPEasy_Storage.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+# include "../../_Plugin_Helper.h"
+
+# include <vector>
+
+# ifdef ESP32
+#  include <lwip/sockets.h>
+# endif // ifdef ESP32
+
+
+// Interval to send a comment to check whether the client is still connected.
+# define EVENTS_KEEPALIVE_INTERVAL 15000
+
+struct EventsClient {
+  EventsClient(const WiFiClient& c) : client(c), pendingTasks(TASKS_MAX, true), lastSent(millis()) {}
+
+  WiFiClient        client;
+  std::vector<bool> pendingTasks;
+  unsigned long     lastSent;
+};
+
+static std::vector<EventsClient> events_clients;
+
+static void events_remove_disconnected()
+{
+  for (auto it = events_clients.begin(); it != events_clients.end();) {
+    if (it->client.connected()) {
+      ++it;
+    } else {
+      it->client.stop();
+      it = events_clients.erase(it);
+    }
+  }
+}
+
+// Write the complete data, or nothing when the client cannot accept it right now.
+// Return false when the data was not sent.
+static bool events_write(WiFiClient& client, const String& data)
+{
+  # ifdef ESP8266
+
+  if (static_cast<size_t>(client.availableForWrite()) < data.length()) {
+    return false;
+  }
+  # endif // ifdef ESP8266
+  # ifdef ESP32
+
+  // WiFiClient::write() keeps retrying until all is sent, so first check the socket is writable.
+  // A writable socket has at least TCP_SNDLOWAT bytes free in its send buffer,
+  // which is a lot more than the size of an event.
+  const int fd = client.fd();
+
+  if (fd < 0) {
+    return false;
+  }
+  fd_set set;
+  struct timeval tv = { 0, 0 };
+
+  FD_ZERO(&set);
+  FD_SET(fd, &set);
+
+  if (select(fd + 1, nullptr, &set, nullptr, &tv) <= 0) {
+    return false;
+  }
+  # endif // ifdef ESP32
+
+  if (client.write(data.c_str(), data.length()) != data.length()) {
+    // Partly sent event cannot be recovered.
+    client.stop();
+    return false;
+  }
+  return true;
+}
+
+// Append the value, escaping line breaks as they would end the "data:" line.
+static void events_append_escaped(String& data, const String& value)
+{
+  const unsigned int length = value.length();
+
+  for (unsigned int i = 0; i < length; ++i) {
+    const char c = value[i];
+
+    switch (c) {
+      case '\\': data += F("\\\\"); break;
+      case '\n': data += F("\\n"); break;
+      case '\r': data += F("\\r"); break;
+      default:   data += c; break;
+    }
+  }
+}
+
+static String events_format_task_values(taskIndex_t TaskIndex)
+{
+  String data;
+
+  if (!validDeviceIndex(getDeviceIndex_from_TaskIndex(TaskIndex))) {
+    return data;
+  }
+  const byte valueCount = getValueCountForTask(TaskIndex);
+
+  if (valueCount == 0) {
+    return data;
+  }
+  LoadTaskSettings(TaskIndex);
+  data.reserve(valueCount * 20 + 1);
+
+  for (byte x = 0; x < valueCount; x++) {
+    data += F("data: ");
+    data += TaskIndex + 1;
+    data += ',';
+    data += x + 1;
+    data += ',';
+    events_append_escaped(data, formatUserVarNoCheck(TaskIndex, x));
+    data += '\n';
+  }
+  data += '\n';
+  return data;
+}
+
+void handle_events()
+{
+  events_remove_disconnected();
+
+  if (events_clients.size() >= WEBSERVER_EVENTS_MAX_CLIENTS) {
+    web_server.send(503, F("text/plain"), F("Too many clients"));
+    return;
+  }
+
+  WiFiClient client = web_server.client();
+
+  client.print(F("HTTP/1.1 200 OK\r\n"
+                 "Content-Type: text/event-stream\r\n"
+                 "Cache-Control: no-cache\r\n"
+                 "Access-Control-Allow-Origin: *\r\n"
+                 "\r\n"
+                 "retry: 5000\n\n"));
+
+  // Keep a copy of the client, so the connection stays open after this request has been handled.
+  // All tasks are pending, to send the current values first.
+  events_clients.emplace_back(client);
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    String log = F("Events: Client connected: ");
+    log += formatIP(client.remoteIP());
+    addLog(LOG_LEVEL_INFO, log);
+  }
+}
+
+void events_task_values_changed(taskIndex_t TaskIndex)
+{
+  if (!validTaskIndex(TaskIndex)) {
+    return;
+  }
+
+  for (auto it = events_clients.begin(); it != events_clients.end(); ++it) {
+    it->pendingTasks[TaskIndex] = true;
+  }
+}
+
+void events_loop()
+{
+  if (events_clients.empty()) {
+    return;
+  }
+  events_remove_disconnected();
+
+  // Tasks are formatted once, for all clients waiting for them.
+  for (taskIndex_t TaskIndex = 0; validTaskIndex(TaskIndex); ++TaskIndex) {
+    String data;
+    bool   formatted = false;
+
+    for (auto it = events_clients.begin(); it != events_clients.end(); ++it) {
+      if (!it->pendingTasks[TaskIndex] || !it->client.connected()) {
+        continue;
+      }
+
+      if (!formatted) {
+        data      = events_format_task_values(TaskIndex);
+        formatted = true;
+      }
+
+      if (data.length() == 0) {
+        it->pendingTasks[TaskIndex] = false;
+      } else if (events_write(it->client, data)) {
+        it->pendingTasks[TaskIndex] = false;
+        it->lastSent                = millis();
+      }
+
+      // else: Client is slow, keep the task pending and send the latest values later.
+    }
+  }
+
+  for (auto it = events_clients.begin(); it != events_clients.end(); ++it) {
+    if (it->client.connected() && (timePassedSince(it->lastSent) > EVENTS_KEEPALIVE_INTERVAL)) {
+      if (events_write(it->client, F(":\n\n"))) {
+        it->lastSent = millis();
+      }
+    }
+  }
+}
+
+#endif // ifdef WEBSERVER_EVENTS
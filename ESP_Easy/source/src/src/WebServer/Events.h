@@ -0,0 +1,28 @@
+#ifndef WEBSERVER_WEBSERVER_EVENTS_H
+#define WEBSERVER_WEBSERVER_EVENTS_H
+
+#include "../WebServer/common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+#ifdef WEBSERVER_EVENTS
+
+// ********************************************************************************
+// Server-Sent Events stream of task values (no password!)
+// Each event contains a line per task value: "task,value_index,value"
+// (task and value index start at 1, like in /json)
+// Line breaks and backslashes in values are escaped as "\n", "\r" and "\\".
+// ********************************************************************************
+void handle_events();
+
+// Task has new values, send them to the connected clients.
+void events_task_values_changed(taskIndex_t TaskIndex);
+
+// Send pending task values to the connected clients.
+// A task with new values is sent only once, using the latest values,
+// so intermediate values are dropped when a client cannot keep up.
+void events_loop();
+
+#endif // ifdef WEBSERVER_EVENTS
+
+#endif // ifndef WEBSERVER_WEBSERVER_EVENTS_H
@@ -4,13 +4,17 @@
 #include "../WebServer/JSON.h"
 #include "../WebServer/Markup_Forms.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/Nodes.h"
 #include "../Globals/Device.h"
 #include "../Globals/Plugins.h"
+#include "../Globals/RTC.h"
+#include "../Globals/RuntimeData.h"
 
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/Hardware.h"
+#include "../Helpers/Memory.h"
 #include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringProvider.h"
@@ -98,11 +102,116 @@ void handle_csvval()
   addHtml(htmlData);
   TXBuffer.endStream();
 }
+// ********************************************************************************
+// Get the /json snapshot of the task values.
+// When the task values have changed, the generation of the snapshot is updated
+// and the formatted values are cleared.
+// ********************************************************************************
+JsonTaskValuesSnapshot& getJsonTaskValuesSnapshot(taskIndex_t TaskIndex, byte valueCount)
+{
+  uint32_t rawValues[VARS_PER_TASK] = { 0 };
+
+  for (byte x = 0; x < valueCount && x < VARS_PER_TASK; x++) {
+    rawValues[x] = UserVar.getUint32(TaskIndex, x);
+  }
+
+  auto it = Cache.jsonTaskValues.find(TaskIndex);
+
+  if (it == Cache.jsonTaskValues.end()) {
+    JsonTaskValuesSnapshot& snapshot = Cache.jsonTaskValues[TaskIndex];
+    memcpy(snapshot.rawValues, rawValues, sizeof(rawValues));
+    snapshot.generation = ++Cache.jsonTaskValuesGeneration;
+    return snapshot;
+  }
+
+  JsonTaskValuesSnapshot& snapshot = it->second;
+
+  if (memcmp(snapshot.rawValues, rawValues, sizeof(rawValues)) != 0) {
+    memcpy(snapshot.rawValues, rawValues, sizeof(rawValues));
+    snapshot.json       = String();
+    snapshot.generation = ++Cache.jsonTaskValuesGeneration;
+  }
+  return snapshot;
+}
+
+// ********************************************************************************
+// Check all tasks for changed values.
+// Return the current generation of the task values.
+// ********************************************************************************
+uint32_t updateJsonTaskValuesGeneration()
+{
+  for (taskIndex_t TaskIndex = 0; validTaskIndex(TaskIndex); TaskIndex++) {
+    if (validDeviceIndex(getDeviceIndex_from_TaskIndex(TaskIndex))) {
+      const byte valueCount = getValueCountForTask(TaskIndex);
+
+      if (valueCount != 0) {
+        getJsonTaskValuesSnapshot(TaskIndex, valueCount);
+      }
+    }
+  }
+  return Cache.jsonTaskValuesGeneration;
+}
+
+// ********************************************************************************
+// Stream the "TaskValues" array of a task.
+// The formatted values are kept per task and only formatted again
+// when the task values have changed or the task has sent new data.
+// ********************************************************************************
+void stream_json_task_values(taskIndex_t TaskIndex, byte valueCount)
+{
+  JsonTaskValuesSnapshot& snapshot = getJsonTaskValuesSnapshot(TaskIndex, valueCount);
+
+  if (snapshot.json.length() != 0) {
+    addHtml(snapshot.json);
+    return;
+  }
+
+  LoadTaskSettings(TaskIndex);
+  String json;
+
+  json.reserve(20 + valueCount * 80);
+  json += F("\"TaskValues\": [\n");
+
+  for (byte x = 0; x < valueCount; x++)
+  {
+    json += '{';
+    const String value = formatUserVarNoCheck(TaskIndex, x);
+    byte nrDecimals    = ExtraTaskSettings.TaskDeviceValueDecimals[x];
+
+    if (mustConsiderAsString(value)) {
+      // Flag as not to treat as a float
+      nrDecimals = 255;
+    }
+    json += to_json_object_value(F("ValueNumber"), String(x + 1));
+    json += F(",\n");
+    json += to_json_object_value(F("Name"),        String(ExtraTaskSettings.TaskDeviceValueNames[x]));
+    json += F(",\n");
+    json += to_json_object_value(F("NrDecimals"),  String(nrDecimals));
+    json += F(",\n");
+    json += to_json_object_value(F("Value"),       value);
+    json += F("\n}");
+
+    if (x < (valueCount - 1)) {
+      json += F(",\n");
+    }
+  }
+  json += F("],\n");
+  addHtml(json);
+
+  if (FreeMem() >= (json.length() + JSON_TASK_VALUES_CACHE_MIN_FREE_MEM)) {
+    std::swap(snapshot.json, json);
+  }
+}
+
 // ********************************************************************************
 // Web Interface JSON page (no password!)
 // ********************************************************************************
 void handle_json()
 {
+  START_TIMER
+  #ifndef BUILD_NO_DEBUG
+  const unsigned long jsonStart = micros();
+  #endif // ifndef BUILD_NO_DEBUG
   const taskIndex_t taskNr    = getFormItemInt(F("tasknr"), INVALID_TASK_INDEX);
   const bool showSpecificTask = validTaskIndex(taskNr);
   bool showSystem             = true;
@@ -113,6 +222,7 @@ void handle_json()
   bool showDataAcquisition    = true;
   bool showTaskDetails        = true;
   bool showNodes              = true;
+  bool sensorUpdate           = false;
   {
     String view = web_server.arg("view");
 
@@ -126,10 +236,59 @@ void handle_json()
         showDataAcquisition = false;
         showTaskDetails     = false;
         showNodes           = false;
+        sensorUpdate        = true;
       }
     }
   }
 
+  // With "since=<generation>&boot=<boot>" only the tasks with values changed after that generation are included.
+  // The generation restarts at every boot, so it is only valid along with the matching boot counter.
+  bool     onlyChangedTasks = false;
+  uint32_t sinceGeneration  = 0;
+  uint32_t generation       = 0;
+
+  if (!showSpecificTask) {
+    const String since = web_server.arg(F("since"));
+    const String boot  = web_server.arg(F("boot"));
+
+    if ((since.length() != 0) && (boot.length() != 0)) {
+      unsigned int tmp     = 0;
+      unsigned int tmpBoot = 0;
+      onlyChangedTasks = validUIntFromString(since, tmp) &&
+                         validUIntFromString(boot, tmpBoot) &&
+                         (tmpBoot == RTC.bootCounter);
+      sinceGeneration = tmp;
+    }
+  }
+
+  if (sensorUpdate || onlyChangedTasks) {
+    generation = updateJsonTaskValuesGeneration();
+
+    if (onlyChangedTasks && (sinceGeneration > generation)) {
+      // Generation not given by this node, send all tasks.
+      onlyChangedTasks = false;
+    }
+  }
+
+  if (sensorUpdate) {
+    // The sensor update only contains task values and task settings,
+    // so it has not changed as long as the generation is the same.
+    String etag;
+    etag.reserve(24);
+    etag += '"';
+    etag += RTC.bootCounter;
+    etag += '-';
+    etag += generation;
+    etag += '"';
+
+    if (web_server.header(F("If-None-Match")) == etag) {
+      web_server.send(304);
+      STOP_TIMER(HANDLE_SERVING_JSON);
+      return;
+    }
+    web_server.sendHeader(F("ETag"), etag);
+  }
+
   TXBuffer.startJsonStream();
 
   if (!showSpecificTask)
@@ -283,6 +442,8 @@ void handle_json()
   // Keep track of the lowest reported TTL and use that as refresh interval.
   unsigned long lowest_ttl_json = 60;
 
+  bool firstTask = true;
+
   for (taskIndex_t TaskIndex = firstTaskIndex; TaskIndex <= lastActiveTaskIndex && validTaskIndex(TaskIndex); TaskIndex++)
   {
     const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(TaskIndex);
@@ -290,13 +451,22 @@ void handle_json()
     if (validDeviceIndex(DeviceIndex))
     {
       const unsigned long taskInterval = Settings.TaskDeviceTimer[TaskIndex];
-      LoadTaskSettings(TaskIndex);
+      const byte valueCount = getValueCountForTask(TaskIndex);
+
+      if (onlyChangedTasks &&
+          ((valueCount == 0) || (getJsonTaskValuesSnapshot(TaskIndex, valueCount).generation <= sinceGeneration))) {
+        continue;
+      }
+
+      if (!firstTask) {
+        addHtml(F(",\n"));
+      }
+      firstTask = false;
       addHtml(F("{\n"));
 
       unsigned long ttl_json = 60; // Default value
 
       // For simplicity, do the optional values first.
-      const byte valueCount = getValueCountForTask(TaskIndex);
       if (valueCount != 0) {
         if ((taskInterval > 0) && Settings.TaskDeviceEnabled[TaskIndex]) {
           ttl_json = taskInterval;
@@ -305,27 +475,7 @@ void handle_json()
             lowest_ttl_json = ttl_json;
           }
         }
-        addHtml(F("\"TaskValues\": [\n"));
-
-        for (byte x = 0; x < valueCount; x++)
-        {
-          addHtml('{');
-          const String value = formatUserVarNoCheck(TaskIndex, x);
-          byte nrDecimals = ExtraTaskSettings.TaskDeviceValueDecimals[x];
-          if (mustConsiderAsString(value)) {
-            // Flag as not to treat as a float
-            nrDecimals = 255;
-          }
-          stream_next_json_object_value(F("ValueNumber"), String(x + 1));
-          stream_next_json_object_value(F("Name"),        String(ExtraTaskSettings.TaskDeviceValueNames[x]));
-          stream_next_json_object_value(F("NrDecimals"),  String(nrDecimals));
-          stream_last_json_object_value(F("Value"),       value);
-
-          if (x < (valueCount - 1)) {
-            addHtml(F(",\n"));
-          }
-        }
-        addHtml(F("],\n"));
+        stream_json_task_values(TaskIndex, valueCount);
       }
 
       if (showSpecificTask) {
@@ -350,6 +500,7 @@ void handle_json()
       }
 
       if (showTaskDetails) {
+        LoadTaskSettings(TaskIndex);
         stream_next_json_object_value(F("TaskInterval"),     String(taskInterval));
         stream_next_json_object_value(F("Type"),             getPluginNameFromDeviceIndex(DeviceIndex));
         stream_next_json_object_value(F("TaskName"),         String(ExtraTaskSettings.TaskDeviceName));
@@ -385,20 +536,43 @@ void handle_json()
       }
       stream_next_json_object_value(F("TaskEnabled"), jsonBool(Settings.TaskDeviceEnabled[TaskIndex]));
       stream_last_json_object_value(F("TaskNumber"), String(TaskIndex + 1));
-
-      if (TaskIndex != lastActiveTaskIndex) {
-        addHtml(",");
-      }
-      addHtml("\n");
     }
   }
 
+  if (!firstTask) {
+    addHtml("\n");
+  }
+
   if (!showSpecificTask) {
     addHtml(F("],\n"));
+
+    if (sensorUpdate || onlyChangedTasks) {
+      stream_next_json_object_value(F("Generation"), String(generation));
+      stream_next_json_object_value(F("Boot"),       String(RTC.bootCounter));
+    }
     stream_last_json_object_value(F("TTL"), String(lowest_ttl_json * 1000));
   }
 
   TXBuffer.endStream();
+  STOP_TIMER(HANDLE_SERVING_JSON);
+  #ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    const long duration = usecPassedSince(jsonStart);
+    String     log      = F("JSON : Sent ");
+    log += TXBuffer.sentBytes;
+    log += F(" bytes in ");
+    log += duration;
+    log += F(" usec");
+
+    if (duration > 0) {
+      log += F(" (");
+      log += static_cast<unsigned long>((static_cast<uint64_t>(TXBuffer.sentBytes) * 1000) / duration);
+      log += F(" bytes/msec)");
+    }
+    addLog(LOG_LEVEL_DEBUG, log);
+  }
+  #endif // ifndef BUILD_NO_DEBUG
 }
 
 // ********************************************************************************
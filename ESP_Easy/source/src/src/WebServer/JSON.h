@@ -4,12 +4,32 @@
 
 #include "../WebServer/common.h"
 
+#include "../DataStructs/Caches.h"
+#include "../DataTypes/TaskIndex.h"
+
 
 // ********************************************************************************
 // Web Interface get CSV value from task
 // ********************************************************************************
 void handle_csvval();
 
+// ********************************************************************************
+// Snapshot of the task values served by /json, see Caches::jsonTaskValues
+// ********************************************************************************
+JsonTaskValuesSnapshot& getJsonTaskValuesSnapshot(taskIndex_t TaskIndex,
+                                                  byte        valueCount);
+
+// ********************************************************************************
+// Check all tasks for changed values and return the current generation.
+// ********************************************************************************
+uint32_t                updateJsonTaskValuesGeneration();
+
+// ********************************************************************************
+// Stream the "TaskValues" array of a task.
+// ********************************************************************************
+void stream_json_task_values(taskIndex_t TaskIndex,
+                             byte        valueCount);
+
 // ********************************************************************************
 // Web Interface JSON page (no password!)
 // ********************************************************************************
@@ -10,16 +10,22 @@
 
 #include "../Commands/Diagnostic.h"
 
+#include "../ControllerQueue/DelayQueueElements.h"
+
 #include "../DataStructs/RTCStruct.h"
+#include "../DataStructs/SyslogQueue.h"
 
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/ESPEasyWifi.h"
 
 #include "../Globals/CRCValues.h"
 #include "../Globals/ESPEasy_time.h"
+#include "../Globals/EventQueue.h"
+#include "../Globals/Logging.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/RTC.h"
 
+#include "../Helpers/_CPlugin_DomoticzHelper.h"
 #include "../Helpers/CompiletimeDefines.h"
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Helpers/ESPEasy_Storage.h"
@@ -312,6 +318,32 @@ void handle_sysinfo_basicInfo() {
   addRowLabelValue(LabelType::RESET_REASON);
   addRowLabelValue(LabelType::LAST_TASK_BEFORE_REBOOT);
   addRowLabelValue(LabelType::SW_WD_COUNT);
+  addRowLabel(F("Event Queue"));
+  addHtml(eventQueue.getQueueStats());
+
+  if (Settings.Syslog_IP[0] != 0) {
+    addRowLabel(F("Syslog Queue"));
+    addHtml(syslogQueue.getQueueStats());
+  }
+  #ifdef USES_MQTT
+
+  if (MQTTDelayHandler != nullptr) {
+    String html;
+    html.reserve(64);
+    html += MQTTDelayHandler->size();
+    html += F(" items, ");
+    html += MQTTDelayHandler->getQueueMemorySize();
+    html += F(" bytes (avg: ");
+    html += MQTTDelayHandler->getAverageElementSize();
+    html += F(" bytes/publish)");
+    addRowLabel(F("MQTT Queue"));
+    addHtml(html);
+  }
+  #endif // ifdef USES_MQTT
+  #ifdef USES_C002
+  addRowLabel(F("Domoticz IDX Filter"));
+  addHtml(getDomoticzIdxFilterStats());
+  #endif // ifdef USES_C002
 }
 
 void handle_sysinfo_memory() {
@@ -7,7 +7,10 @@
 
 #include "../DataTypes/ESPEasy_plugin_functions.h"
 
+#include "../DataStructs/LogStruct.h"
+
 #include "../Globals/ESPEasy_time.h"
+#include "../Globals/Logging.h"
 #include "../Globals/Protocol.h"
 #include "../Globals/RamTracker.h"
 
@@ -50,6 +53,32 @@ void handle_timingstats() {
   addHtml(F(" sec"));
   addRowLabel(F("*"));
   addHtml(F("Duty cycle based on average < 1 msec is highly unreliable"));
+
+  // Compare the binary web log entries with storing them as String.
+  // Compare "addToLog() structured" with "addToLog() text" for the time spent in the loop.
+  addFormHeader(F("Web Log Buffer"));
+  addRowLabel(F("Buffer"));
+  {
+    String html;
+    html.reserve(64);
+    html += Logging.getUsedSize();
+    html += '/';
+    html += Logging.getMemorySize();
+    html += F(" bytes, ");
+    html += Logging.getNrEntries();
+    html += F(" entries");
+    addHtml(html);
+  }
+  addRowLabel(F("Avg. Entry Size"));
+  {
+    String html;
+    html.reserve(64);
+    html += String(Logging.getAvgEntrySize(), 1);
+    html += F(" bytes (as String: ");
+    html += String(Logging.getAvgTextSize(), 1);
+    html += F(" bytes)");
+    addHtml(html);
+  }
   html_end_table();
 
   sendHeadandTail_stdtemplate(_TAIL);
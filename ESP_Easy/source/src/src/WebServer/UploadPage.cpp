@@ -4,6 +4,8 @@
 #include "../WebServer/AccessControl.h"
 #include "../WebServer/HTML_wrappers.h"
 
+#include "../ESPEasyCore/ESPEasyRules.h"
+
 #include "../Globals/Cache.h"
 #include "../Helpers/ESPEasy_Storage.h"
 
@@ -50,6 +52,7 @@ void handle_upload_post() {
       addHtml(F("Upload OK!<BR>You may need to reboot to apply all settings..."));
       clearAllCaches();
       LoadSettings();
+      checkRuleSets();
       break;
     case uploadResult_e::InvalidFile:
       addHtml(F("<font color=\"red\">Upload file invalid!</font>"));
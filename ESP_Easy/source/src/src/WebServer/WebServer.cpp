@@ -10,6 +10,7 @@
 #include "../WebServer/CustomPage.h"
 #include "../WebServer/DevicesPage.h"
 #include "../WebServer/DownloadPage.h"
+#include "../WebServer/Events.h"
 #include "../WebServer/FactoryResetPage.h"
 #include "../WebServer/Favicon.h"
 #include "../WebServer/FileList.h"
@@ -268,6 +269,9 @@ void WebServerInit()
   #endif // ifdef WEBSERVER_I2C_SCANNER
   web_server.on(F("/json"),            handle_json); // Also part of WEBSERVER_NEW_UI
   web_server.on(F("/csv"),             handle_csvval);
+  #ifdef WEBSERVER_EVENTS
+  web_server.on(F("/events"),          handle_events);
+  #endif // ifdef WEBSERVER_EVENTS
   web_server.on(F("/log"),             handle_log);
   web_server.on(F("/login"),           handle_login);
   web_server.on(F("/logjson"),         handle_log_JSON); // Also part of WEBSERVER_NEW_UI
@@ -330,6 +334,12 @@ void WebServerInit()
 
   web_server.onNotFound(handleNotFound);
 
+  {
+    // Request headers are only kept by the web server when asked for.
+    const char *headerKeys[] = { "If-None-Match" };
+    web_server.collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
+  }
+
   #if defined(ESP8266) || defined(ESP32)
   {
     # ifndef NO_HTTP_UPDATER